@@ -0,0 +1,30 @@
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <stddef.h>
+
+/**
+ * @brief Pluggable memory source for the library's containers.
+ *
+ * Every call carries the size of the block involved, so sized allocators
+ * (size-class pools, arenas) need no per-block header. 'ctx' is passed
+ * back unchanged to each callback. An Allocator must outlive every
+ * container created with it.
+ */
+typedef struct Allocator {
+    void* (*alloc)(void *ctx, size_t size);
+    void* (*realloc)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+    void (*free)(void *ctx, void *ptr, size_t size);
+    void *ctx;
+} Allocator;
+
+/**
+ * @brief Returns the allocator backed by malloc, realloc and free.
+ *
+ * Containers created without an explicit allocator use this one.
+ *
+ * @return A pointer to a static Allocator.
+ */
+const Allocator* allocator_default(void);
+
+#endif // ALLOCATOR_H
@@ -0,0 +1,123 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include "allocator.h" // For Allocator
+
+/**
+ * @brief Default size of an arena block when arena_create() is given 0.
+ */
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+/**
+ * @brief One chunk of arena memory; the usable bytes follow the header.
+ */
+typedef struct ArenaBlock {
+    struct ArenaBlock *next; // Next block in the chain, kept for reuse after a release or reset
+    size_t size;             // Usable bytes after the header
+} ArenaBlock;
+
+/**
+ * @brief A checkpoint returned by arena_mark().
+ */
+typedef struct ArenaMark {
+    ArenaBlock *block;
+    size_t used;
+} ArenaMark;
+
+/**
+ * @brief Region allocator: bump-pointer allocation, freed all at once.
+ *
+ * Allocations are carved from the current block by advancing 'used'.
+ * When a block runs out the arena moves to the next block in the chain,
+ * or mallocs a new one. Rolling back (arena_release, arena_reset) only
+ * moves the cursor, so blocks stay allocated and are reused. Memory goes
+ * back to the system only in arena_destroy().
+ *
+ * Not thread-safe.
+ */
+typedef struct Arena {
+    ArenaBlock *first;
+    ArenaBlock *current;   // Block allocations are carved from
+    size_t used;           // Bytes used in 'current'
+    size_t block_size;     // Usable size of regular blocks
+    char *last;            // Most recent allocation, which may grow or shrink in place
+    Allocator allocator;   // Adapter returned by arena_allocator(); ctx is the arena
+} Arena;
+
+// --- Function Prototypes ---
+
+/**
+ * @brief Creates an arena with one block ready.
+ *
+ * @param block_size Usable bytes per block, or 0 for ARENA_DEFAULT_BLOCK_SIZE.
+ *        Larger requests get a block of their own.
+ * @return A pointer to the new Arena, or NULL on failure.
+ */
+Arena* arena_create(size_t block_size);
+
+/**
+ * @brief Allocates 'size' bytes aligned to 'align'.
+ *
+ * @param arena A pointer to the arena.
+ * @param size The number of bytes needed.
+ * @param align A power of two.
+ * @return A pointer to the memory, or NULL on failure or invalid alignment.
+ */
+void* arena_alloc(Arena *arena, size_t size, size_t align);
+
+/**
+ * @brief Returns a checkpoint for arena_release().
+ * @param arena A pointer to the arena.
+ */
+ArenaMark arena_mark(const Arena *arena);
+
+/**
+ * @brief Frees everything allocated since 'mark' was taken, in O(1).
+ *
+ * Marks taken after 'mark' become invalid.
+ *
+ * @param arena A pointer to the arena.
+ * @param mark A checkpoint from arena_mark() on this arena.
+ */
+void arena_release(Arena *arena, ArenaMark mark);
+
+/**
+ * @brief Frees every allocation in O(1); the blocks are kept for reuse.
+ *
+ * Containers whose every allocation went through arena_allocator() need
+ * not be destroyed first, but must not be used afterwards. That includes
+ * a LinkedList with a private pool, whose slabs come from its allocator.
+ * Memory a container got elsewhere, such as from a MemPool passed to
+ * createListWithPool(), is not reclaimed by a reset.
+ *
+ * @param arena A pointer to the arena.
+ */
+void arena_reset(Arena *arena);
+
+/**
+ * @brief Returns the bytes held in blocks, used or not.
+ * @param arena A pointer to the arena.
+ */
+size_t arena_capacity(const Arena *arena);
+
+/**
+ * @brief Returns an Allocator that serves containers from the arena.
+ *
+ * Blocks are aligned for any type. free is a no-op, apart from rolling
+ * back the most recent allocation. realloc of the most recent allocation
+ * grows or shrinks it in place when the block has room, so a vector that
+ * is the last thing allocated grows without copying.
+ *
+ * @param arena A pointer to the arena.
+ * @return A pointer to the Allocator embedded in the arena; valid until arena_destroy().
+ */
+const Allocator* arena_allocator(Arena *arena);
+
+/**
+ * @brief Frees all blocks and the arena.
+ * @param arena A pointer to the arena; NULL is ignored.
+ */
+void arena_destroy(Arena *arena);
+
+#endif // ARENA_H
@@ -0,0 +1,107 @@
+#ifndef CONCURRENT_POOL_H
+#define CONCURRENT_POOL_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "diag.h" // For LibStatus
+
+/**
+ * @brief Number of blocks a per-thread magazine can hold.
+ *
+ * A magazine refills with, and flushes, half of this at a time, so a
+ * thread that alternates allocate/deallocate never touches the shared list.
+ */
+#define CONCURRENT_POOL_MAGAZINE_SIZE 64
+
+/**
+ * @brief Per-thread cache of free blocks sitting in front of the shared free list.
+ */
+typedef struct PoolMagazine {
+    struct ConcurrentPool *pool;
+    struct PoolMagazine *next_registered; // Chain used by destroyConcurrentPool()
+    size_t count;
+    void *blocks[CONCURRENT_POOL_MAGAZINE_SIZE];
+} PoolMagazine;
+
+/**
+ * @brief Fixed-size block pool that can be shared between threads.
+ *
+ * Free blocks form a lock-free stack. Each free block stores the index
+ * of the next one, and the head packs a 32-bit block index with a 32-bit
+ * version tag into one 64-bit word. Every push or pop bumps the tag, so
+ * a compare-and-swap on a head that was popped and pushed back in the
+ * meantime fails, which rules out ABA. Each thread allocates through its
+ * own magazine, and only refills and flushes touch the shared head. A
+ * thread whose magazine could not be set up uses the shared list directly.
+ *
+ * Magazines are found through one pthread key per pool, so at most
+ * PTHREAD_KEYS_MAX pools (fewer, counting keys used elsewhere in the
+ * process) can exist at once; createConcurrentPool() fails beyond that.
+ */
+typedef struct ConcurrentPool {
+    _Alignas(64) _Atomic uint64_t free_head; // (tag << 32) | (block index + 1), 0 = empty
+    _Alignas(64) size_t block_size;
+    size_t num_blocks;
+    char *buffer;
+    pthread_key_t magazine_key;
+    pthread_mutex_t registry_lock;
+    PoolMagazine *magazines;
+} ConcurrentPool;
+
+// --- Function Prototypes ---
+
+/**
+ * @brief Creates a thread-safe memory pool.
+ *
+ * @param num_blocks The total number of blocks (at most UINT32_MAX - 1).
+ * @param block_size The size of each block in bytes.
+ * @return A pointer to the initialized ConcurrentPool, or NULL on failure.
+ */
+ConcurrentPool* createConcurrentPool(size_t num_blocks, size_t block_size);
+
+/**
+ * @brief Allocates a block. Safe to call from any thread.
+ *
+ * Served from the calling thread's magazine. An empty magazine first takes
+ * a batch from the shared free list with a single compare-and-swap.
+ *
+ * @param pool A pointer to the pool.
+ * @return A pointer to a free block, or NULL if the pool is exhausted.
+ */
+void* concurrentAllocate(ConcurrentPool *pool);
+
+/**
+ * @brief Returns a block to the pool. Safe to call from any thread.
+ *
+ * The block goes into the calling thread's magazine. A full magazine
+ * first flushes half its blocks to the shared list with one compare-and-swap.
+ *
+ * @param pool A pointer to the pool.
+ * @param ptr A block previously returned by concurrentAllocate() on this pool.
+ */
+void concurrentDeallocate(ConcurrentPool *pool, void *ptr);
+
+/**
+ * @brief Flushes the calling thread's magazine back to the shared free list.
+ *
+ * Use this before a thread goes idle for a long time, so other threads
+ * can use its cached blocks. Magazines are also flushed when their
+ * thread exits.
+ *
+ * @param pool A pointer to the pool.
+ */
+void concurrentPoolFlushThreadCache(ConcurrentPool *pool);
+
+/**
+ * @brief Destroys the pool, its buffer and all per-thread magazines.
+ *
+ * No other thread may be using the pool, and threads that used it must
+ * not exit while it is being destroyed.
+ *
+ * @param pool A pointer to the pool to destroy.
+ */
+void destroyConcurrentPool(ConcurrentPool *pool);
+
+#endif // CONCURRENT_POOL_H
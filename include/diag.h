@@ -0,0 +1,62 @@
+#ifndef DIAG_H
+#define DIAG_H
+
+/**
+ * @brief Status codes returned by the library's int-returning operations.
+ *
+ * Success is always 0 and every failure is negative, so existing
+ * "!= 0" / "== 0" checks keep working while callers that care can
+ * tell the failure kinds apart.
+ */
+typedef enum LibStatus {
+    LIB_OK = 0,
+    LIB_ERR_INVALID_ARG = -1,  // NULL handle or argument
+    LIB_ERR_OUT_OF_RANGE = -2, // index or position outside the container
+    LIB_ERR_NO_MEMORY = -3,    // an allocation failed
+    LIB_ERR_NOT_FOUND = -4,    // the requested value is not present
+    LIB_ERR_EXHAUSTED = -5,    // a fixed-capacity resource has no room left
+    LIB_ERR_IO = -6,           // reading or writing a file failed
+    LIB_ERR_CORRUPT = -7       // stored data failed its format or checksum checks
+} LibStatus;
+
+/**
+ * @brief Severity passed to the trace hook.
+ */
+typedef enum DiagLevel {
+    DIAG_TRACE, // per-operation events (inserts, deletes, pool create/destroy)
+    DIAG_ERROR  // failures that are also reported through a LibStatus
+} DiagLevel;
+
+/**
+ * @brief Callback receiving diagnostic messages.
+ *
+ * @param level The severity of the message.
+ * @param func The library function that produced it.
+ * @param message The formatted message text.
+ * @param ctx The context pointer given to diag_set_trace_hook().
+ */
+typedef void (*DiagTraceHook)(DiagLevel level, const char *func, const char *message, void *ctx);
+
+/**
+ * @brief Returns a short human-readable name for a status code.
+ * @param status A LibStatus value.
+ * @return A static string such as "out of range".
+ */
+const char* lib_status_str(int status);
+
+/**
+ * @brief Installs (or with NULL removes) the runtime trace hook.
+ *
+ * Diagnostics exist only when the library is built with
+ * MY_C_LIB_DIAGNOSTICS (on by default for Debug builds). In such a build,
+ * every message goes to the hook while one is installed; without a hook,
+ * errors go to stderr and trace messages are dropped. In a release build
+ * the diagnostics are compiled out and this call has no effect.
+ * Install the hook before other threads start using the library.
+ *
+ * @param hook The callback, or NULL to restore the default behaviour.
+ * @param ctx An opaque pointer handed back to the hook.
+ */
+void diag_set_trace_hook(DiagTraceHook hook, void *ctx);
+
+#endif // DIAG_H
@@ -0,0 +1,137 @@
+#ifndef DOUBLY_LINKED_LIST_H
+#define DOUBLY_LINKED_LIST_H
+
+#include <stddef.h> // For NULL and size_t
+#include "mempool.h" // For MemPool-backed node allocation
+#include "allocator.h" // For Allocator
+
+// 1. Structure for a single node in the doubly linked list
+typedef struct DNode {
+    int data;           // Data stored in the node
+    struct DNode *prev; // Pointer to the previous node in the list
+    struct DNode *next; // Pointer to the next node in the list
+} DNode;
+
+// 2. Structure for the doubly linked list itself (head, tail and size)
+typedef struct DoublyLinkedList {
+    DNode *head;       // Pointer to the first node in the list
+    DNode *tail;       // Pointer to the last node in the list
+    size_t size;       // Current number of elements in the list
+    MemPool *pool;     // Pool serving the nodes, or NULL to use the allocator
+    const Allocator *allocator; // Source of the struct, and of nodes when there is no pool
+} DoublyLinkedList;
+
+// --- Function Prototypes (Declarations) ---
+
+/**
+ * @brief Initializes a new empty doubly linked list.
+ * @return A pointer to the newly created DoublyLinkedList, or NULL on failure.
+ */
+DoublyLinkedList* createDList(void);
+
+/**
+ * @brief Initializes a new empty doubly linked list that takes all its memory from an allocator.
+ * @param allocator The allocator for the list and its nodes, e.g. pool_allocator().
+ * @return A pointer to the newly created DoublyLinkedList, or NULL on failure.
+ */
+DoublyLinkedList* createDListWithAllocator(const Allocator *allocator);
+
+/**
+ * @brief Initializes a new empty doubly linked list whose nodes come from a caller-owned pool.
+ *
+ * The pool must have a block size of at least sizeof(DNode) and must outlive
+ * the list. Growth follows the pool's own policy.
+ *
+ * @param pool A pointer to the MemPool to allocate nodes from.
+ * @return A pointer to the newly created DoublyLinkedList, or NULL on failure.
+ */
+DoublyLinkedList* createDListWithPool(MemPool *pool);
+
+/**
+ * @brief Inserts a new node at the beginning of the list.
+ * @param list A pointer to the DoublyLinkedList.
+ * @param data The data to be stored in the new node.
+ * @return A handle to the new node, or NULL on failure.
+ */
+DNode* dlistInsertAtBeginning(DoublyLinkedList *list, int data);
+
+/**
+ * @brief Inserts a new node at the end of the list.
+ * @param list A pointer to the DoublyLinkedList.
+ * @param data The data to be stored in the new node.
+ * @return A handle to the new node, or NULL on failure.
+ */
+DNode* dlistInsertAtEnd(DoublyLinkedList *list, int data);
+
+/**
+ * @brief Inserts a new node directly after an existing node in O(1).
+ * @param list A pointer to the DoublyLinkedList.
+ * @param node A node handle belonging to this list.
+ * @param data The data to be stored in the new node.
+ * @return A handle to the new node, or NULL on failure.
+ */
+DNode* dlistInsertAfterNode(DoublyLinkedList *list, DNode *node, int data);
+
+/**
+ * @brief Searches for the first node holding a specific value.
+ * @param list A pointer to the DoublyLinkedList.
+ * @param data The data to search for.
+ * @return A handle to the node containing the data, or NULL if not found.
+ */
+DNode* dlistSearch(DoublyLinkedList *list, int data);
+
+/**
+ * @brief Unlinks and frees a node in O(1) given its handle.
+ *
+ * The handle must come from an insert or from dlistSearch() on the same list
+ * and is invalid after this call.
+ *
+ * @param list A pointer to the DoublyLinkedList.
+ * @param node The node to remove.
+ * @return 1 if removal was successful, 0 if the list or node is NULL.
+ */
+int dlistRemoveNode(DoublyLinkedList *list, DNode *node);
+
+/**
+ * @brief Moves an existing node to the front of the list in O(1), e.g. on an LRU hit.
+ * @param list A pointer to the DoublyLinkedList.
+ * @param node A node handle belonging to this list.
+ */
+void dlistMoveToFront(DoublyLinkedList *list, DNode *node);
+
+/**
+ * @brief Removes the first node and returns its data.
+ * @param list A pointer to the DoublyLinkedList.
+ * @param out Receives the removed data; may be NULL.
+ * @return 1 if a node was removed, 0 if the list is empty or NULL.
+ */
+int dlistPopFront(DoublyLinkedList *list, int *out);
+
+/**
+ * @brief Removes the last node and returns its data.
+ * @param list A pointer to the DoublyLinkedList.
+ * @param out Receives the removed data; may be NULL.
+ * @return 1 if a node was removed, 0 if the list is empty or NULL.
+ */
+int dlistPopBack(DoublyLinkedList *list, int *out);
+
+/**
+ * @brief Prints all elements in the list from head to tail.
+ * @param list A pointer to the DoublyLinkedList.
+ */
+void printDList(DoublyLinkedList *list);
+
+/**
+ * @brief Returns the current number of elements in the list.
+ * @param list A pointer to the DoublyLinkedList.
+ * @return The size of the list.
+ */
+size_t getDListSize(DoublyLinkedList *list);
+
+/**
+ * @brief Deallocates all memory used by the list.
+ * @param list A pointer to the DoublyLinkedList.
+ */
+void destroyDList(DoublyLinkedList *list);
+
+#endif // DOUBLY_LINKED_LIST_H
@@ -3,27 +3,330 @@
 #define LINKED_LIST_H
 
 #include <stddef.h> // For NULL and size_t
+#include "mempool.h" // For MemPool-backed node allocation
+#include "diag.h"    // For LibStatus
+#include "allocator.h" // For Allocator
+#include "stats.h"   // For ListStats
 
 // 1. Structure for a single node in the linked list
 typedef struct Node {
-    int data;          // Data stored in the node (can be any type, e.g., void* for generic list)
     struct Node *next; // Pointer to the next node in the list
+    int data;          // Data stored in the node of an int list
 } Node;
 
-// 2. Structure for the linked list itself (head and size)
+/**
+ * @brief Layout of a node in a list with an arbitrary payload.
+ *
+ * The payload is stored inline right after 'next', so a small record shares
+ * a cache line with its link. Node is the same layout with an int payload.
+ * Payloads are aligned to a pointer.
+ */
+typedef struct ListNode {
+    struct Node *next;
+    unsigned char payload[]; // payload_size bytes, fixed when the list is created
+} ListNode;
+
+/**
+ * @brief Matches a search key against a payload: returns 0 when they match.
+ *
+ * qsort-style comparators work as long as they return 0 for equal elements.
+ */
+typedef int (*ListCompareFn)(const void *key, const void *payload);
+
+/**
+ * @brief Selects payloads for list_remove_if(): returns nonzero to remove.
+ */
+typedef int (*ListPredicateFn)(const void *payload, void *ctx);
+
+/**
+ * @brief Orders two payloads like a qsort comparator: negative, 0 or positive.
+ */
+typedef int (*ListOrderFn)(const void *a, const void *b);
+
+/**
+ * @brief Settings for createListWithConfig().
+ *
+ * Keys are matched with 'compare' when it is set. Otherwise the key is the
+ * 'key_size' bytes at 'key_offset' in the payload and is compared bytewise.
+ */
+typedef struct ListConfig {
+    size_t payload_size;        // Bytes stored inline in every node
+    ListCompareFn compare;      // Key matcher, or NULL to compare key bytes
+    size_t key_offset;          // Offset of the key in the payload when compare is NULL
+    size_t key_size;            // Size of that key; 0 means the whole payload
+    const Allocator *allocator; // Source of the struct, the nodes and the private pool's slabs; NULL for allocator_default()
+    size_t nodes_per_slab;      // Nonzero: nodes come from a private pool with slabs of this many nodes
+} ListConfig;
+
+struct ListIndex; // Private hash index, see enableListIndex()
+
+// 2. Structure for the linked list itself (head, tail and size)
 typedef struct LinkedList {
     Node *head;        // Pointer to the first node in the list
+    Node *tail;        // Pointer to the last node in the list, for O(1) appends
     size_t size;       // Current number of elements in the list
+    MemPool *pool;     // Pool serving the nodes, or NULL to use the allocator
+    int owns_pool;     // 1 if the list created the pool and destroys it with the list
+    const Allocator *allocator; // Source of the struct, and of nodes when there is no pool
+    struct ListIndex *index;    // Key -> first node hash index, or NULL when not enabled
+    size_t payload_size;        // Bytes of payload per node (sizeof(int) for int lists)
+    size_t node_size;           // Bytes allocated per node
+    ListCompareFn compare;      // See ListConfig
+    size_t key_offset;
+    size_t key_size;
+#ifdef MY_C_LIB_STATS
+    ListStats stats;
+#endif
 } LinkedList;
 
+/**
+ * @brief Returns the payload stored in a node.
+ */
+static inline void* list_payload(Node *node) {
+    return ((ListNode *)node)->payload;
+}
+
 // --- Function Prototypes (Declarations) ---
 
 /**
  * @brief Initializes a new empty linked list.
- * @return A pointer to the newly created LinkedList.
+ * @return A pointer to the newly created LinkedList, or NULL on failure.
  */
 LinkedList* createList();
 
+/**
+ * @brief Initializes a new empty linked list that takes all its memory from an allocator.
+ * @param allocator The allocator for the list and its nodes, e.g. pool_allocator().
+ * @return A pointer to the newly created LinkedList, or NULL on failure.
+ */
+LinkedList* createListWithAllocator(const Allocator *allocator);
+
+/**
+ * @brief Initializes a new empty linked list whose nodes come from a caller-owned pool.
+ *
+ * The pool must have a block size of at least sizeof(Node) and must outlive
+ * the list. Whether the pool grows when it runs out follows the pool's own
+ * growth policy (see createPoolWithConfig()).
+ *
+ * @param pool A pointer to the MemPool to allocate nodes from.
+ * @return A pointer to the newly created LinkedList, or NULL if the pool is unsuitable.
+ */
+LinkedList* createListWithPool(MemPool *pool);
+
+/**
+ * @brief Initializes a new empty linked list that owns a private node pool.
+ *
+ * Nodes are carved from a first slab of 'nodes_per_slab' nodes, and the pool
+ * doubles with a new slab whenever the current ones are used up. destroyList() then releases
+ * the slabs directly instead of freeing the nodes one by one.
+ *
+ * @param nodes_per_slab The number of nodes in the first slab.
+ * @return A pointer to the newly created LinkedList, or NULL on failure.
+ */
+LinkedList* createPooledList(size_t nodes_per_slab);
+
+/**
+ * @brief Creates an empty list whose nodes carry an inline payload of any size.
+ *
+ * The int functions below (insertAtEnd, searchList, ...) are wrappers over
+ * the list_* functions for lists made by createList() and its variants,
+ * whose payload is a single int that is also the key. The list_* functions
+ * work on any list.
+ *
+ * @param config The payload size, key matching and memory source.
+ * @return A pointer to the newly created LinkedList, or NULL on failure.
+ */
+LinkedList* createListWithConfig(const ListConfig *config);
+
+/**
+ * @brief Copies a payload into a new node at the front of the list.
+ * @param list A pointer to the LinkedList.
+ * @param payload The payload_size bytes to store.
+ * @return LIB_OK on success, or a negative LibStatus on failure.
+ */
+int list_push_front(LinkedList *list, const void *payload);
+
+/**
+ * @brief Copies a payload into a new node at the end of the list in O(1).
+ * @param list A pointer to the LinkedList.
+ * @param payload The payload_size bytes to store.
+ * @return LIB_OK on success, or a negative LibStatus on failure.
+ */
+int list_push_back(LinkedList *list, const void *payload);
+
+/**
+ * @brief Inserts a payload after the first node matching a key.
+ * @param list A pointer to the LinkedList.
+ * @param payload The payload_size bytes to store.
+ * @param after_key The key of the node to insert after.
+ * @return 1 if insertion was successful, 0 if the key was not found or allocation failed.
+ */
+int list_insert_after(LinkedList *list, const void *payload, const void *after_key);
+
+/**
+ * @brief Finds the first node matching a key.
+ * @param list A pointer to the LinkedList.
+ * @param key The key to look for: key_size bytes, or whatever 'compare' expects.
+ * @return A pointer to the node's payload, or NULL if not found.
+ */
+void* list_find(LinkedList *list, const void *key);
+
+/**
+ * @brief Deletes the first node matching a key.
+ * @param list A pointer to the LinkedList.
+ * @param key The key of the node to delete.
+ * @return 1 if deletion was successful, 0 if the key was not found.
+ */
+int list_remove(LinkedList *list, const void *key);
+
+/**
+ * @brief Deletes the node at a position (0-indexed).
+ * @param list A pointer to the LinkedList.
+ * @param position The position of the node to delete.
+ * @param out Receives the deleted payload, or NULL to discard it.
+ * @return LIB_OK on success, or LIB_ERR_OUT_OF_RANGE / LIB_ERR_INVALID_ARG.
+ */
+int list_remove_at(LinkedList *list, size_t position, void *out);
+
+/**
+ * @brief Creates a list holding copies of 'count' payloads, in array order.
+ *
+ * Nodes are linked as they are created, in one pass. With a private pool
+ * (config->nodes_per_slab > 0) the first slab is made large enough for
+ * the whole array.
+ *
+ * @param config The list settings, or NULL for an int list.
+ * @param payloads An array of 'count' payloads of config->payload_size bytes.
+ * @param count The number of payloads.
+ * @return A pointer to the new LinkedList, or NULL on failure.
+ */
+LinkedList* list_from_array(const ListConfig *config, const void *payloads, size_t count);
+
+/**
+ * @brief Removes every node whose payload satisfies 'pred', in one pass.
+ *
+ * The removed nodes are freed together after the pass; a pooled list
+ * returns them to its pool in one splice. An enabled index is rebuilt
+ * during the same pass.
+ *
+ * @param list A pointer to the LinkedList.
+ * @param pred Called once per payload, in list order.
+ * @param ctx Passed through to 'pred'.
+ * @return The number of nodes removed.
+ */
+size_t list_remove_if(LinkedList *list, ListPredicateFn pred, void *ctx);
+
+/**
+ * @brief Removes every node whose key is one of 'values', in one pass.
+ *
+ * 'values' are loaded into a temporary hash set first, so the cost is
+ * O(n + count) rather than a scan of the list per value. Only lists whose
+ * keys could be indexed (see enableListIndex()) are supported.
+ *
+ * @param list A pointer to the LinkedList.
+ * @param values An array of 'count' keys of key_size bytes each.
+ * @param count The number of keys.
+ * @param removed Receives the number of nodes removed; may be NULL.
+ * @return LIB_OK, LIB_ERR_INVALID_ARG, or LIB_ERR_NO_MEMORY with the list untouched.
+ */
+int list_remove_all_of(LinkedList *list, const void *values, size_t count, size_t *removed);
+
+/**
+ * @brief Keeps only the first node holding each key, in one pass.
+ *
+ * Unlike a sort-based unique, the list need not be sorted and the order of
+ * the kept nodes is unchanged. Keys seen so far are tracked in the list's
+ * index when it is enabled, or in a temporary hash set otherwise. Only
+ * lists whose keys could be indexed (see enableListIndex()) are supported.
+ *
+ * @param list A pointer to the LinkedList.
+ * @param removed Receives the number of nodes removed; may be NULL.
+ * @return LIB_OK, LIB_ERR_INVALID_ARG, or LIB_ERR_NO_MEMORY with the list untouched.
+ */
+int list_unique(LinkedList *list, size_t *removed);
+
+/**
+ * @brief Sorts the list in place with a stable bottom-up merge sort.
+ *
+ * Only the 'next' links are rewritten: no node is allocated, freed or
+ * copied. Already ordered stretches are taken as whole runs, so a sorted
+ * or nearly sorted list costs close to one pass. O(n log n) otherwise.
+ * An enabled index is rebuilt afterwards.
+ *
+ * @param list A pointer to the LinkedList.
+ * @param order The payload order, or NULL to sort an int list ascending.
+ * @return LIB_OK or LIB_ERR_INVALID_ARG.
+ */
+int list_sort(LinkedList *list, ListOrderFn order);
+
+/**
+ * @brief Merges sorted 'src' into sorted 'dest' in O(n + m), leaving 'src' empty.
+ *
+ * Nodes are relinked, not copied; on ties the nodes of 'dest' come first.
+ * The two lists must store nodes the same way: same payload size and
+ * either the same shared pool or, without a pool, the same allocator.
+ * Lists with a private pool (createPooledList) cannot exchange nodes.
+ *
+ * @param dest The list receiving the nodes, sorted by 'order'.
+ * @param src The list giving up its nodes, sorted by 'order'.
+ * @param order The payload order, or NULL for int lists.
+ * @return LIB_OK, LIB_ERR_INVALID_ARG, or LIB_ERR_NO_MEMORY if dest's index
+ *         could not grow (both lists untouched).
+ */
+int list_merge_sorted(LinkedList *dest, LinkedList *src, ListOrderFn order);
+
+/**
+ * @brief Moves every node of 'src' into 'dest' after 'after', in O(1).
+ *
+ * 'src' is left empty. The lists must store nodes the same way, as for
+ * list_merge_sorted(). If 'dest' has an index, the moved nodes are added to
+ * it, which costs O(m) when splicing at the tail and O(n + m) elsewhere.
+ *
+ * @param dest The list receiving the nodes.
+ * @param after A node of 'dest' to insert after, or NULL to insert at the front.
+ * @param src The list giving up its nodes.
+ * @return LIB_OK, LIB_ERR_INVALID_ARG, or LIB_ERR_NO_MEMORY (lists untouched).
+ */
+int list_splice(LinkedList *dest, Node *after, LinkedList *src);
+
+/**
+ * @brief Moves the nodes from 'position' onward into the empty list 'rest'.
+ *
+ * Costs O(position) to find the cut. The lists must store nodes the same
+ * way, as for list_merge_sorted().
+ *
+ * @param list The list to cut.
+ * @param position Index of the first node to move; list size moves nothing.
+ * @param rest An empty list receiving the nodes.
+ * @return LIB_OK, LIB_ERR_INVALID_ARG, LIB_ERR_OUT_OF_RANGE, or
+ *         LIB_ERR_NO_MEMORY if rest's index could not grow (lists untouched).
+ */
+int list_split_at(LinkedList *list, size_t position, LinkedList *rest);
+
+/**
+ * @brief Builds a hash index over the list's keys and keeps it up to date.
+ *
+ * Only lists that compare key bytes (no comparator) with keys of at most
+ * 8 bytes can be indexed; int lists always can.
+ *
+ * While the index is enabled, searchList(), deleteNode() and insertAfter()
+ * (and list_find(), list_remove() and list_insert_after()) find their key in O(1) on average instead of scanning the list. With
+ * duplicate values they still act on the first occurrence; only removing or
+ * inserting a duplicate walks the nodes between it and its neighbouring
+ * occurrence. Each insert and delete pays one extra table update, and the
+ * table takes memory from the list's allocator. Calling it again is a no-op.
+ *
+ * @param list A pointer to the LinkedList.
+ * @return LIB_OK on success, or a negative LibStatus on failure.
+ */
+int enableListIndex(LinkedList *list);
+
+/**
+ * @brief Drops the hash index, returning the list to plain linear scans.
+ * @param list A pointer to the LinkedList.
+ */
+void disableListIndex(LinkedList *list);
+
 /**
  * @brief Checks if the linked list is empty.
  * @param list A pointer to the LinkedList.
@@ -35,22 +338,24 @@ int isEmpty(LinkedList *list);
  * @brief Inserts a new node at the beginning of the list.
  * @param list A pointer to the LinkedList.
  * @param data The data to be stored in the new node.
+ * @return LIB_OK on success, or a negative LibStatus on failure.
  */
-void insertAtBeginning(LinkedList *list, int data);
+int insertAtBeginning(LinkedList *list, int data);
 
 /**
- * @brief Inserts a new node at the end of the list.
+ * @brief Inserts a new node at the end of the list in O(1) using the tail pointer.
  * @param list A pointer to the LinkedList.
  * @param data The data to be stored in the new node.
+ * @return LIB_OK on success, or a negative LibStatus on failure.
  */
-void insertAtEnd(LinkedList *list, int data);
+int insertAtEnd(LinkedList *list, int data);
 
 /**
  * @brief Inserts a new node after a specified value in the list.
  * @param list A pointer to the LinkedList.
  * @param data The data to be stored in the new node.
  * @param after_value The value after which to insert the new node.
- * @return 1 if insertion was successful, 0 if after_value was not found.
+ * @return 1 if insertion was successful, 0 if after_value was not found or allocation failed.
  */
 int insertAfter(LinkedList *list, int data, int after_value);
 
@@ -2,6 +2,9 @@
 #define MEMPOOL_H
 
 #include <stddef.h>
+#include "diag.h" // For LibStatus
+#include "stats.h" // For PoolStats
+#include "allocator.h" // For Allocator
 
 /**
  * @brief Structure for a node in the free list.
@@ -14,25 +17,72 @@ typedef struct FreeNode {
     struct FreeNode *next;
 } FreeNode;
 
+/**
+ * @brief Header placed at the start of every slab.
+ *
+ * Each slab is one allocation holding this header followed by its blocks.
+ * Slabs are chained newest first, so the pool's initial slab is always
+ * the last one in the chain.
+ */
+typedef struct MemPoolSlab {
+    struct MemPoolSlab *next;
+    size_t num_blocks;
+} MemPoolSlab;
+
+/**
+ * @brief How a pool adds slabs when its free list runs dry.
+ */
+typedef enum PoolGrowth {
+    POOL_GROWTH_NONE,   // Fixed size: allocate() returns NULL when exhausted
+    POOL_GROWTH_FIXED,  // Add a slab of 'growth_blocks' blocks each time
+    POOL_GROWTH_DOUBLE  // Add a slab as large as the whole pool so far
+} PoolGrowth;
+
+/**
+ * @brief Parameters for createPoolWithConfig().
+ */
+typedef struct MemPoolConfig {
+    size_t initial_blocks; // Blocks in the first slab
+    size_t block_size;     // Requested size of each block in bytes
+    PoolGrowth growth;     // Growth policy once the first slab is used up
+    size_t growth_blocks;  // Slab size for POOL_GROWTH_FIXED (ignored otherwise)
+    size_t max_blocks;     // Upper bound on blocks across all slabs, 0 for no limit
+    const Allocator *allocator; // Source of the pool and its slabs; NULL for allocator_default()
+} MemPoolConfig;
+
 /**
  * @brief Structure for the memory pool.
  *
- * This holds the entire pre-allocated block of memory and a pointer
- * to the head of the free list.
+ * This holds the chain of slabs, a pointer to the head of the free list
+ * of returned blocks, and a bump region covering the part of the newest
+ * slab that has never been handed out. Blocks in the bump region are not
+ * on the free list, so a new slab costs O(1) and its pages are touched
+ * only when its blocks are first used.
  */
 typedef struct MemPool {
-    size_t total_size;
-    size_t block_size;
-    void *buffer;
+    size_t total_size;        // Bytes of block storage across all slabs
+    size_t block_size;        // Effective (aligned) block size
+    size_t num_blocks;        // Blocks across all slabs
     FreeNode *free_list_head;
+    char *bump_next;          // Next never-used block of the newest slab
+    char *bump_end;           // End of the newest slab's blocks
+    MemPoolSlab *slabs;
+    PoolGrowth growth;
+    size_t growth_blocks;
+    size_t max_blocks;
+    const Allocator *allocator; // Source of the pool structure and the slabs
+#ifdef MY_C_LIB_STATS
+    PoolStats stats;
+#endif
 } MemPool;
 
 // --- Function Prototypes ---
 
 /**
- * @brief Creates a new memory pool.
+ * @brief Creates a new fixed-size memory pool.
  *
- * Allocates a large buffer and initializes a free list.
+ * Allocates a large buffer and initializes a free list. The pool never
+ * grows on its own; use createPoolWithConfig() for on-demand growth.
  *
  * @param num_blocks The total number of memory blocks to pre-allocate.
  * @param block_size The size of each memory block in bytes.
@@ -40,11 +90,21 @@ typedef struct MemPool {
  */
 MemPool* createPool(size_t num_blocks, size_t block_size);
 
+/**
+ * @brief Creates a memory pool that chains extra slabs on demand.
+ *
+ * @param config The initial size, block size, growth policy and limit.
+ * @return A pointer to the initialized MemPool, or NULL on failure.
+ */
+MemPool* createPoolWithConfig(const MemPoolConfig *config);
+
 /**
  * @brief Allocates a block of memory from the pool.
  *
- * This function is a fast alternative to malloc(). It simply pops a
- * node off the free list.
+ * This function is a fast alternative to malloc(). It takes the next
+ * never-used block from the bump region, or else pops a node off the
+ * free list. When both are empty and the pool's growth policy allows
+ * it, a new slab is added first.
  *
  * @param pool A pointer to the memory pool.
  * @return A pointer to a free memory block, or NULL if the pool is exhausted.
@@ -63,7 +123,46 @@ void* allocate(MemPool *pool);
 void deallocate(MemPool *pool, void *ptr);
 
 /**
- * @brief Destroys the memory pool and frees its main buffer.
+ * @brief Returns a chain of blocks to the pool in O(1).
+ *
+ * The blocks must already be linked through their first pointer-sized
+ * word, as FreeNode does, from 'first' to 'last'. The whole chain is
+ * spliced onto the front of the free list at once.
+ *
+ * @param pool A pointer to the memory pool.
+ * @param first The first block of the chain.
+ * @param last The last block of the chain; its link is overwritten.
+ * @param count The number of blocks in the chain.
+ */
+void deallocateChain(MemPool *pool, void *first, void *last, size_t count);
+
+/**
+ * @brief Adds a new slab of blocks to the pool.
+ *
+ * The slab is allocated in one piece and becomes the bump region, so the
+ * next allocate() calls are served from it without walking its blocks.
+ * Any blocks left in the previous bump region are moved to the free list.
+ *
+ * @param pool A pointer to the memory pool.
+ * @param num_blocks The number of blocks to add.
+ * @return LIB_OK on success, LIB_ERR_EXHAUSTED if it would exceed max_blocks,
+ *         or another negative LibStatus on failure.
+ */
+int growPool(MemPool *pool, size_t num_blocks);
+
+/**
+ * @brief Releases every slab except the initial one whose blocks are all free.
+ *
+ * This walks the free list once, so it costs time proportional to the number
+ * of free blocks. Call it from an idle or maintenance path, not per operation.
+ *
+ * @param pool A pointer to the memory pool.
+ * @return The number of bytes of block storage returned to the system.
+ */
+size_t trimPool(MemPool *pool);
+
+/**
+ * @brief Destroys the memory pool and frees every slab.
  *
  * This function must be called to release all memory associated with the pool.
  *
@@ -71,4 +170,4 @@ void deallocate(MemPool *pool, void *ptr);
  */
 void destroyPool(MemPool *pool);
 
-#endif // MEMPOOL_H
\ No newline at end of file
+#endif // MEMPOOL_H
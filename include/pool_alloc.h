@@ -0,0 +1,60 @@
+#ifndef POOL_ALLOC_H
+#define POOL_ALLOC_H
+
+#include <stddef.h>
+#include "allocator.h"
+
+// Size classes are powers of two from POOL_ALLOC_MIN_CLASS to POOL_ALLOC_MAX_CLASS.
+#define POOL_ALLOC_MIN_CLASS 8
+#define POOL_ALLOC_MAX_CLASS 4096
+#define POOL_ALLOC_NUM_CLASSES 10
+
+/**
+ * @brief Allocates 'size' bytes from the size-class pools.
+ *
+ * The request is rounded up to the next power-of-two class and served
+ * by that class's MemPool, which grows one slab at a time. Requests
+ * larger than POOL_ALLOC_MAX_CLASS go to malloc. The class pools are
+ * created on first use.
+ *
+ * Like MemPool, the size-class pools are not thread-safe.
+ *
+ * @param size The number of bytes needed.
+ * @return A pointer to the block, or NULL on failure.
+ */
+void* pool_malloc(size_t size);
+
+/**
+ * @brief Returns a block obtained from pool_malloc() or pool_realloc().
+ *
+ * The size must be the one the block was requested with. It picks the
+ * class without a per-block header.
+ *
+ * @param ptr The block to free; NULL is ignored.
+ * @param size The size passed when the block was allocated.
+ */
+void pool_free(void *ptr, size_t size);
+
+/**
+ * @brief Resizes a block, moving it between classes when needed.
+ *
+ * @param ptr The block to resize, or NULL to allocate.
+ * @param old_size The size the block was allocated with.
+ * @param new_size The size needed now.
+ * @return The (possibly moved) block, or NULL on failure (the old block is kept).
+ */
+void* pool_realloc(void *ptr, size_t old_size, size_t new_size);
+
+/**
+ * @brief Releases fully free slabs of every class back to the system.
+ * @return The number of bytes released.
+ */
+size_t pool_trim(void);
+
+/**
+ * @brief Returns an Allocator that routes container memory through pool_malloc/pool_free.
+ * @return A pointer to a static Allocator.
+ */
+const Allocator* pool_allocator(void);
+
+#endif // POOL_ALLOC_H
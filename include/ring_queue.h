@@ -0,0 +1,120 @@
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+
+/**
+ * @brief Which threads may use a RingQueue at the same time.
+ */
+typedef enum RingQueueMode {
+    RING_QUEUE_SPSC, // One producer thread and one consumer thread
+    RING_QUEUE_MPMC  // Any number of producer and consumer threads
+} RingQueueMode;
+
+/**
+ * @brief Bounded lock-free FIFO of fixed-size elements in one contiguous buffer.
+ *
+ * 'head' and 'tail' count dequeues and enqueues since creation and map to a
+ * slot by masking with the power-of-two capacity. They sit on separate cache
+ * lines, so producers and consumers do not invalidate each other's line on
+ * every operation.
+ *
+ * In SPSC mode the slots are bare elements. Each side also keeps a private
+ * copy of the other side's index and reloads it only when the queue looks
+ * full (or empty), so most operations touch no shared cache line at all.
+ *
+ * In MPMC mode each slot starts with a sequence number, as in Dmitry
+ * Vyukov's bounded queue. A producer claims position p with a
+ * compare-and-swap on 'tail' once slot p's sequence equals p. It publishes
+ * the element by storing p + 1, and the consumer of p frees the slot for the
+ * next lap by storing p + capacity. A batch claims a whole run of ready slots
+ * with one compare-and-swap.
+ */
+typedef struct RingQueue {
+    _Alignas(64) _Atomic size_t head; // Next position to dequeue
+    size_t cached_tail;               // SPSC consumer's last view of 'tail'
+    _Alignas(64) _Atomic size_t tail; // Next position to enqueue
+    size_t cached_head;               // SPSC producer's last view of 'head'
+    _Alignas(64) RingQueueMode mode;
+    size_t capacity;                  // Power of two
+    size_t mask;                      // capacity - 1
+    size_t element_size;
+    size_t slot_size;                 // element_size, plus the sequence word in MPMC mode
+    char *slots;
+} RingQueue;
+
+// --- Function Prototypes ---
+
+/**
+ * @brief Creates an empty queue.
+ *
+ * @param capacity The minimum number of elements; rounded up to a power of two.
+ * @param element_size The size of each element in bytes.
+ * @param mode RING_QUEUE_SPSC or RING_QUEUE_MPMC.
+ * @return A pointer to the new RingQueue, or NULL on failure.
+ */
+RingQueue* ring_queue_create(size_t capacity, size_t element_size, RingQueueMode mode);
+
+/**
+ * @brief Copies one element into the queue without blocking.
+ *
+ * @param queue A pointer to the queue.
+ * @param element The element_size bytes to enqueue.
+ * @return 1 if the element was enqueued, 0 if the queue was full.
+ */
+int ring_queue_enqueue(RingQueue *queue, const void *element);
+
+/**
+ * @brief Copies the oldest element out of the queue without blocking.
+ *
+ * @param queue A pointer to the queue.
+ * @param out Receives element_size bytes.
+ * @return 1 if an element was dequeued, 0 if the queue was empty.
+ */
+int ring_queue_dequeue(RingQueue *queue, void *out);
+
+/**
+ * @brief Enqueues up to 'count' consecutive elements, keeping their order.
+ *
+ * In MPMC mode another producer's elements never land between the elements
+ * of one claimed run, but a batch that only partly fits may be split around them.
+ *
+ * @param queue A pointer to the queue.
+ * @param elements An array of 'count' elements.
+ * @param count The number of elements to enqueue.
+ * @return The number enqueued, from the front of 'elements'; less than
+ *         'count' only if the queue filled up.
+ */
+size_t ring_queue_enqueue_batch(RingQueue *queue, const void *elements, size_t count);
+
+/**
+ * @brief Dequeues up to 'max' elements in FIFO order.
+ *
+ * @param queue A pointer to the queue.
+ * @param out Receives up to 'max' elements.
+ * @param max The capacity of 'out' in elements.
+ * @return The number dequeued; 0 if the queue was empty.
+ */
+size_t ring_queue_dequeue_batch(RingQueue *queue, void *out, size_t max);
+
+/**
+ * @brief Returns the number of queued elements.
+ *
+ * Exact when no other thread is using the queue; otherwise a snapshot
+ * that may already be stale.
+ */
+size_t ring_queue_size(const RingQueue *queue);
+
+/**
+ * @brief Returns the queue's capacity in elements.
+ */
+size_t ring_queue_capacity(const RingQueue *queue);
+
+/**
+ * @brief Destroys the queue and any elements still in it.
+ * @param queue A pointer to the queue; no other thread may be using it.
+ */
+void ring_queue_destroy(RingQueue *queue);
+
+#endif // RING_QUEUE_H
@@ -0,0 +1,148 @@
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+#include <stddef.h>
+#include <stdint.h> // For uint32_t
+#include "diag.h"    // For LibStatus
+#include "mempool.h" // For the per-height node pools
+
+/**
+ * @brief Tallest tower a node can get.
+ *
+ * Each level keeps about a quarter of the nodes of the level below, so 16
+ * levels stay O(log n) up to about four billion keys.
+ */
+#define SKIP_LIST_MAX_LEVEL 16
+
+/**
+ * @brief One entry of a SkipList: a key, its value and its tower of links.
+ */
+typedef struct SkipNode {
+    int key;
+    unsigned int height;       // Number of links in 'next', 1..SKIP_LIST_MAX_LEVEL
+    void *value;
+    struct SkipNode *next[];   // next[0] is the following node in key order
+} SkipNode;
+
+/**
+ * @brief Called by skiplist_range() for each node; returns nonzero to stop.
+ */
+typedef int (*SkipListVisitFn)(const SkipNode *node, void *ctx);
+
+/**
+ * @brief Sorted map from int keys to values, ordered ascending.
+ *
+ * Level 0 links every node in key order; each higher level links a random
+ * quarter of the level below, so a search skips ahead on the top levels and
+ * narrows down on the lower ones in O(log n) expected steps. Equal keys are
+ * allowed and kept in insertion order.
+ *
+ * A node is allocated with exactly 'height' links, from a MemPool dedicated
+ * to that height, so towers cost no wasted pointers and no malloc per insert.
+ *
+ * The last node of every level is remembered in 'tail'. A key that is not
+ * below the current maximum, such as the next timestamp in a time-ordered
+ * index, is appended without a search.
+ *
+ * Not thread-safe.
+ */
+typedef struct SkipList {
+    SkipNode *head[SKIP_LIST_MAX_LEVEL]; // First node of each level
+    SkipNode *tail[SKIP_LIST_MAX_LEVEL]; // Last node of each level
+    unsigned int level;                  // Levels in use; the ones above are empty
+    size_t size;
+    uint32_t rng;                        // xorshift state for tower heights
+    MemPool *pools[SKIP_LIST_MAX_LEVEL]; // pools[h - 1] serves nodes of height h, created on first use
+} SkipList;
+
+// --- Function Prototypes ---
+
+/**
+ * @brief Creates an empty skip list.
+ * @return A pointer to the new SkipList, or NULL on failure.
+ */
+SkipList* skiplist_create(void);
+
+/**
+ * @brief Inserts a key, after any nodes that already hold it.
+ *
+ * @param list A pointer to the skip list.
+ * @param key The key to insert.
+ * @param value Stored with the key; may be NULL.
+ * @return LIB_OK, LIB_ERR_INVALID_ARG or LIB_ERR_NO_MEMORY.
+ */
+int skiplist_insert(SkipList *list, int key, void *value);
+
+/**
+ * @brief Finds the first node holding a key.
+ *
+ * @param list A pointer to the skip list.
+ * @param key The key to look for.
+ * @return The node, or NULL if no node holds 'key'.
+ */
+SkipNode* skiplist_find(const SkipList *list, int key);
+
+/**
+ * @brief Deletes the first node holding a key.
+ *
+ * @param list A pointer to the skip list.
+ * @param key The key to delete.
+ * @return 1 if a node was deleted, 0 if the key was not found.
+ */
+int skiplist_delete(SkipList *list, int key);
+
+/**
+ * @brief Returns the first node whose key is not less than 'key'.
+ *
+ * @param list A pointer to the skip list.
+ * @param key The lower bound.
+ * @return The node, or NULL if every key is less than 'key'.
+ */
+SkipNode* skiplist_lower_bound(const SkipList *list, int key);
+
+/**
+ * @brief Visits the nodes with keys in [low, high] in ascending order.
+ *
+ * Finds 'low' in O(log n), then follows level 0.
+ *
+ * @param list A pointer to the skip list.
+ * @param low The smallest key to visit.
+ * @param high The largest key to visit.
+ * @param visit Called once per node, until it returns nonzero.
+ * @param ctx Passed through to 'visit'.
+ * @return The number of nodes visited.
+ */
+size_t skiplist_range(const SkipList *list, int low, int high, SkipListVisitFn visit, void *ctx);
+
+/**
+ * @brief Returns the node with the smallest key, or NULL if the list is empty.
+ */
+static inline SkipNode* skiplist_first(const SkipList *list) {
+    return list->head[0];
+}
+
+/**
+ * @brief Returns the node after 'node' in key order, or NULL at the end.
+ *
+ * With skiplist_lower_bound() this iterates a range without a callback.
+ * Deleting the node invalidates it, so step past it first.
+ */
+static inline SkipNode* skiplist_next(const SkipNode *node) {
+    return node->next[0];
+}
+
+/**
+ * @brief Returns the number of nodes in the skip list.
+ */
+size_t skiplist_size(const SkipList *list);
+
+/**
+ * @brief Destroys the skip list and all of its nodes.
+ *
+ * Values are not freed.
+ *
+ * @param list A pointer to the skip list; NULL is ignored.
+ */
+void skiplist_destroy(SkipList *list);
+
+#endif // SKIP_LIST_H
@@ -0,0 +1,65 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "diag.h"        // For LibStatus
+#include "linked_list.h" // For LinkedList
+#include "vector.h"      // For Vector
+
+/**
+ * @brief Binary snapshots of a Vector or an int LinkedList.
+ *
+ * A snapshot file is a fixed header (magic, format version, container kind,
+ * byte-order mark, element size, element count and a checksum of those
+ * fields), then the elements back to back, then a 64-bit checksum of the
+ * elements. Files are written and read in 1 MiB blocks. They are meant to be
+ * loaded on a machine with the same byte order; loading rejects anything else.
+ *
+ * Saving overwrites 'path' in place. For a crash-safe checkpoint, save to a
+ * temporary name and rename() it over the old snapshot.
+ *
+ * Every function returns LIB_OK or a negative LibStatus: LIB_ERR_IO when the
+ * file cannot be opened, read or written, and LIB_ERR_CORRUPT when its
+ * header or checksum does not match.
+ */
+
+/**
+ * @brief Writes every element of a vector to a snapshot file.
+ * @param vec The vector to save.
+ * @param path The file to create or overwrite.
+ * @return LIB_OK on success, or a negative LibStatus on failure.
+ */
+int vector_save(const Vector *vec, const char *path);
+
+/**
+ * @brief Reads a vector snapshot into a new heap vector.
+ *
+ * The elements are read straight into the new vector's buffer, which is
+ * sized once from the header.
+ *
+ * @param path The snapshot file.
+ * @param out Receives the new vector (free it with vector_destroy()); untouched on failure.
+ * @return LIB_OK on success, or a negative LibStatus on failure.
+ */
+int vector_load(const char *path, Vector **out);
+
+/**
+ * @brief Writes the values of a list, head to tail, to a snapshot file.
+ * @param list The int list to save.
+ * @param path The file to create or overwrite.
+ * @return LIB_OK on success, or a negative LibStatus on failure.
+ */
+int list_save(const LinkedList *list, const char *path);
+
+/**
+ * @brief Reads a list snapshot into a new pooled list in one pass.
+ *
+ * The list is created with createPooledList() sized to the element count,
+ * so every node comes from a single slab, laid out in list order.
+ *
+ * @param path The snapshot file.
+ * @param out Receives the new list (free it with destroyList()); untouched on failure.
+ * @return LIB_OK on success, or a negative LibStatus on failure.
+ */
+int list_load(const char *path, LinkedList **out);
+
+#endif // SNAPSHOT_H
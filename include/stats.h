@@ -0,0 +1,99 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * @brief Per-instance counters for a Vector.
+ */
+typedef struct VectorStats {
+    size_t allocations;    // Buffer allocations, including the initial one
+    size_t resizes;        // Capacity changes (growth, reserve, shrink_to_fit)
+    size_t bytes_allocated; // Sum of the buffer sizes requested over the vector's life
+    size_t current_bytes;  // Bytes in the current buffer
+    size_t peak_bytes;     // Largest buffer held at any time
+    size_t peak_size;      // Largest element count reached
+} VectorStats;
+
+/**
+ * @brief Per-instance counters for a LinkedList.
+ */
+typedef struct ListStats {
+    size_t node_allocations; // Nodes created
+    size_t node_frees;       // Nodes handed back one at a time (deletes, destroyList without an owned pool)
+    size_t bytes_allocated;  // Node bytes requested
+    size_t searches;         // Lookups by value or position
+    size_t traversal_steps;  // Nodes visited while walking the list
+    size_t peak_size;        // Largest element count reached
+} ListStats;
+
+/**
+ * @brief Per-instance counters for a MemPool.
+ */
+typedef struct PoolStats {
+    size_t allocations;       // Successful allocate() calls
+    size_t deallocations;     // Blocks returned by deallocate() or deallocateChain()
+    size_t in_use;            // Blocks currently handed out
+    size_t peak_in_use;       // High-water mark of in_use
+    size_t slabs_added;       // Slabs created, including the initial one
+    size_t slabs_released;    // Slabs returned by trimPool()
+    size_t exhaustion_events; // allocate() calls that returned NULL
+} PoolStats;
+
+struct Vector;
+struct LinkedList;
+struct MemPool;
+
+/**
+ * @brief Reports whether the library was built with MY_C_LIB_STATS.
+ * @return 1 if counters are maintained, 0 if they are compiled out.
+ */
+int stats_enabled(void);
+
+/**
+ * @brief Copies a container's counters. All fields are zero when stats are compiled out.
+ * @param vec The vector to read.
+ * @param out Receives the counters.
+ */
+void vector_get_stats(const struct Vector *vec, VectorStats *out);
+
+/**
+ * @brief Copies a list's counters. All fields are zero when stats are compiled out.
+ * @param list The list to read.
+ * @param out Receives the counters.
+ */
+void list_get_stats(const struct LinkedList *list, ListStats *out);
+
+/**
+ * @brief Copies a pool's counters. All fields are zero when stats are compiled out.
+ * @param pool The pool to read.
+ * @param out Receives the counters.
+ */
+void pool_get_stats(const struct MemPool *pool, PoolStats *out);
+
+/**
+ * @brief Writes a vector's counters and shape as one JSON object.
+ * @param out The stream to write to.
+ * @param name A label for the instance, emitted as the "name" field.
+ * @param vec The vector to report.
+ */
+void vector_stats_dump_json(FILE *out, const char *name, const struct Vector *vec);
+
+/**
+ * @brief Writes a list's counters and size as one JSON object.
+ * @param out The stream to write to.
+ * @param name A label for the instance, emitted as the "name" field.
+ * @param list The list to report.
+ */
+void list_stats_dump_json(FILE *out, const char *name, const struct LinkedList *list);
+
+/**
+ * @brief Writes a pool's counters and geometry as one JSON object.
+ * @param out The stream to write to.
+ * @param name A label for the instance, emitted as the "name" field.
+ * @param pool The pool to report.
+ */
+void pool_stats_dump_json(FILE *out, const char *name, const struct MemPool *pool);
+
+#endif // STATS_H
@@ -0,0 +1,79 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stddef.h>
+#include <pthread.h>
+#include "diag.h" // For LibStatus
+
+/**
+ * @brief Body of a parallel job: called once for every task index in [0, tasks).
+ */
+typedef void (*ThreadPoolTaskFn)(void *arg, size_t task);
+
+/**
+ * @brief A fixed set of worker threads that run data-parallel jobs.
+ *
+ * thread_pool_run() hands out task indices to the workers and to the calling
+ * thread through one shared atomic counter, so uneven tasks balance
+ * themselves, and returns once every task has finished. One job runs at a
+ * time; concurrent callers queue up on 'run_lock'. A task that calls
+ * thread_pool_run() itself, on any pool, gets its nested job run inline on
+ * its own thread rather than waiting on 'run_lock'.
+ */
+typedef struct ThreadPool {
+    pthread_t *threads;
+    size_t num_threads;          // Worker threads, not counting the caller
+    pthread_mutex_t lock;        // Guards 'job', 'generation' and 'shutting_down'
+    pthread_cond_t work_ready;   // Signalled when a job is posted or on shutdown
+    pthread_cond_t work_done;    // Signalled when the last worker leaves a job
+    pthread_mutex_t run_lock;    // Serializes thread_pool_run() callers
+    struct ThreadPoolJob *job;   // Job being run, or NULL
+    unsigned long generation;    // Bumped per job so a worker joins each job at most once
+    int shutting_down;
+} ThreadPool;
+
+/**
+ * @brief Starts a pool.
+ * @param num_threads Worker threads to start; 0 means one per online CPU,
+ *        minus one for the thread that calls thread_pool_run().
+ * @return A pointer to the new ThreadPool, or NULL on failure.
+ */
+ThreadPool* thread_pool_create(size_t num_threads);
+
+/**
+ * @brief Runs fn(arg, i) for every i in [0, tasks) and waits for all of them.
+ *
+ * The calling thread works on tasks too, so a pool with no workers simply
+ * runs the job inline. So does a call made from inside a task: nested jobs
+ * are not spread over the workers, which are busy with the outer job.
+ *
+ * @param pool The pool, or NULL to run every task on the calling thread.
+ * @param fn The task body.
+ * @param arg Passed unchanged to every call.
+ * @param tasks The number of task indices.
+ * @return LIB_OK, or LIB_ERR_INVALID_ARG if fn is NULL.
+ */
+int thread_pool_run(ThreadPool *pool, ThreadPoolTaskFn fn, void *arg, size_t tasks);
+
+/**
+ * @brief Returns how many threads work on a job: the workers plus the caller.
+ * @param pool The pool, or NULL (which counts as 1).
+ */
+size_t thread_pool_concurrency(const ThreadPool *pool);
+
+/**
+ * @brief Returns the process-wide pool used by the vector algorithms.
+ *
+ * It is created on first use with thread_pool_create(0) and lives until the
+ * process exits. Returns NULL if it could not be started; the algorithms
+ * then run single-threaded.
+ */
+ThreadPool* thread_pool_default(void);
+
+/**
+ * @brief Stops and joins the workers and frees the pool.
+ * @param pool The pool to destroy; must not be running a job.
+ */
+void thread_pool_destroy(ThreadPool *pool);
+
+#endif // THREAD_POOL_H
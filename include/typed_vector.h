@@ -0,0 +1,155 @@
+#ifndef TYPED_VECTOR_H
+#define TYPED_VECTOR_H
+
+#include <assert.h> // For the debug-only bounds check in _get
+#include <stddef.h> // For size_t
+#include <stdint.h> // For SIZE_MAX
+#include <string.h> // For memcpy
+#include "allocator.h" // For Allocator
+#include "diag.h"      // For LibStatus
+
+// Type-specialized vector generated at compile time.
+//
+//     DEFINE_VECTOR(int, IntVec)
+//
+// defines a value type 'IntVec' { int *data; size_t size; size_t capacity; ... }
+// and static inline functions IntVec_init, IntVec_push, IntVec_get, ... that
+// work on int* directly. sizeof(T) is a compile-time constant, so pushes and
+// gets inline to plain loads and stores, and loops over 'data' auto-vectorize.
+// The element memory comes from an Allocator, as with Vector. int-returning
+// functions return LIB_OK or a negative LibStatus.
+//
+// Iterate with TYPED_VECTOR_FOREACH(ptr, &vec) or a plain loop over
+// vec.data[0 .. vec.size).
+#define TYPED_VECTOR_FOREACH(ptr, vec) \
+    for ((ptr) = (vec)->data; (ptr) < (vec)->data + (vec)->size; ++(ptr))
+
+#define DEFINE_VECTOR(T, Name)                                                              \
+typedef struct Name {                                                                       \
+    T *data;                                                                                \
+    size_t size;                                                                            \
+    size_t capacity;                                                                        \
+    const Allocator *allocator;                                                             \
+} Name;                                                                                     \
+                                                                                            \
+static inline int Name##_init_with_allocator(Name *v, size_t initial_capacity,              \
+                                             const Allocator *allocator) {                  \
+    v->data = NULL;                                                                         \
+    v->size = 0;                                                                            \
+    v->capacity = 0;                                                                        \
+    v->allocator = allocator;                                                               \
+    if (initial_capacity == 0) {                                                            \
+        return LIB_OK;                                                                      \
+    }                                                                                       \
+    if (initial_capacity > SIZE_MAX / sizeof(T)) {                                          \
+        return LIB_ERR_NO_MEMORY;                                                           \
+    }                                                                                       \
+    v->data = (T *)allocator->alloc(allocator->ctx, initial_capacity * sizeof(T));          \
+    if (v->data == NULL) {                                                                  \
+        return LIB_ERR_NO_MEMORY;                                                           \
+    }                                                                                       \
+    v->capacity = initial_capacity;                                                         \
+    return LIB_OK;                                                                          \
+}                                                                                           \
+                                                                                            \
+static inline int Name##_init(Name *v, size_t initial_capacity) {                           \
+    return Name##_init_with_allocator(v, initial_capacity, allocator_default());            \
+}                                                                                           \
+                                                                                            \
+static inline void Name##_free(Name *v) {                                                   \
+    if (v->data != NULL) {                                                                  \
+        v->allocator->free(v->allocator->ctx, v->data, v->capacity * sizeof(T));            \
+    }                                                                                       \
+    v->data = NULL;                                                                         \
+    v->size = 0;                                                                            \
+    v->capacity = 0;                                                                        \
+}                                                                                           \
+                                                                                            \
+static inline int Name##_set_capacity(Name *v, size_t new_capacity) {                       \
+    if (new_capacity > SIZE_MAX / sizeof(T)) {                                              \
+        return LIB_ERR_NO_MEMORY;                                                           \
+    }                                                                                       \
+    T *new_data = (T *)v->allocator->realloc(v->allocator->ctx, v->data,                    \
+                                             v->capacity * sizeof(T),                       \
+                                             new_capacity * sizeof(T));                     \
+    if (new_data == NULL) {                                                                 \
+        return LIB_ERR_NO_MEMORY;                                                           \
+    }                                                                                       \
+    v->data = new_data;                                                                     \
+    v->capacity = new_capacity;                                                             \
+    return LIB_OK;                                                                          \
+}                                                                                           \
+                                                                                            \
+static inline int Name##_reserve(Name *v, size_t capacity) {                                \
+    return capacity <= v->capacity ? LIB_OK : Name##_set_capacity(v, capacity);             \
+}                                                                                           \
+                                                                                            \
+/* Doubles, or jumps straight to min_capacity, so appends stay amortized O(1) */            \
+static inline int Name##_grow(Name *v, size_t min_capacity) {                               \
+    size_t new_capacity = v->capacity > 0 ? v->capacity * 2 : 8;                            \
+    if (new_capacity < min_capacity) {                                                      \
+        new_capacity = min_capacity;                                                        \
+    }                                                                                       \
+    return Name##_set_capacity(v, new_capacity);                                            \
+}                                                                                           \
+                                                                                            \
+static inline int Name##_push(Name *v, T value) {                                           \
+    if (v->size == v->capacity) {                                                           \
+        int status = Name##_grow(v, v->size + 1);                                           \
+        if (status != LIB_OK) {                                                             \
+            return status;                                                                  \
+        }                                                                                   \
+    }                                                                                       \
+    v->data[v->size++] = value;                                                             \
+    return LIB_OK;                                                                          \
+}                                                                                           \
+                                                                                            \
+static inline int Name##_append_n(Name *v, const T *src, size_t count) {                    \
+    if (count > SIZE_MAX - v->size) {                                                       \
+        return LIB_ERR_NO_MEMORY;                                                           \
+    }                                                                                       \
+    if (v->size + count > v->capacity) {                                                    \
+        /* 'src' may point into this vector: locate it again after the grow */              \
+        int aliases = src >= v->data && src < v->data + v->size;                            \
+        size_t src_offset = aliases ? (size_t)(src - v->data) : 0;                          \
+        int status = Name##_grow(v, v->size + count);                                       \
+        if (status != LIB_OK) {                                                             \
+            return status;                                                                  \
+        }                                                                                   \
+        if (aliases) {                                                                      \
+            src = v->data + src_offset;                                                     \
+        }                                                                                   \
+    }                                                                                       \
+    if (count > 0) {                                                                        \
+        memcpy(v->data + v->size, src, count * sizeof(T));                                  \
+    }                                                                                       \
+    v->size += count;                                                                       \
+    return LIB_OK;                                                                          \
+}                                                                                           \
+                                                                                            \
+/* Unchecked in release builds; asserts the index in debug builds */                        \
+static inline T *Name##_get(const Name *v, size_t index) {                                  \
+    assert(index < v->size);                                                                \
+    return v->data + index;                                                                 \
+}                                                                                           \
+                                                                                            \
+static inline int Name##_pop(Name *v, T *out) {                                             \
+    if (v->size == 0) {                                                                     \
+        return LIB_ERR_OUT_OF_RANGE;                                                        \
+    }                                                                                       \
+    v->size--;                                                                              \
+    if (out != NULL) {                                                                      \
+        *out = v->data[v->size];                                                            \
+    }                                                                                       \
+    return LIB_OK;                                                                          \
+}                                                                                           \
+                                                                                            \
+static inline size_t Name##_size(const Name *v) {                                           \
+    return v->size;                                                                         \
+}                                                                                           \
+                                                                                            \
+static inline void Name##_clear(Name *v) {                                                  \
+    v->size = 0;                                                                            \
+}
+
+#endif // TYPED_VECTOR_H
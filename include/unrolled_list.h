@@ -0,0 +1,138 @@
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include <stddef.h> // For NULL and size_t
+#include "allocator.h" // For Allocator
+
+// Number of values per node: whatever fills a 64-byte cache line after the
+// 'next' pointer and the count (13 on 64-bit targets, 14 on 32-bit ones).
+#define ULIST_NODE_VALUES ((64 - sizeof(void *) - sizeof(int)) / sizeof(int))
+
+// 1. Structure for a single node: a short array of values in list order
+typedef struct UNode {
+    struct UNode *next;            // Pointer to the next node in the list
+    int count;                     // Number of used slots in 'values'
+    int values[ULIST_NODE_VALUES]; // values[0 .. count) hold data
+} UNode;
+
+// 2. Structure for the unrolled list itself
+typedef struct UnrolledList {
+    UNode *head;       // Pointer to the first node in the list
+    UNode *tail;       // Pointer to the last node in the list
+    size_t size;       // Current number of values in the list
+    size_t node_count; // Current number of nodes
+    const Allocator *allocator; // Source of the struct and of every node
+} UnrolledList;
+
+// --- Function Prototypes (Declarations) ---
+// Same operations and semantics as LinkedList, but each node carries up to
+// ULIST_NODE_VALUES ints, so a traversal touches one cache line per node
+// rather than one per value. That holds for the default allocator, whose nodes
+// are 64-byte aligned; with a custom allocator a node may straddle two lines
+// unless the allocator returns 64-byte aligned blocks. Nodes are split when an
+// insert lands in a full one and merged with their successor when they fall
+// below half full.
+
+/**
+ * @brief Initializes a new empty unrolled list.
+ * @return A pointer to the newly created UnrolledList, or NULL on failure.
+ */
+UnrolledList* createUList(void);
+
+/**
+ * @brief Initializes a new empty unrolled list that takes all its memory from an allocator.
+ * @param allocator The allocator for the list and its nodes, e.g. pool_allocator().
+ * @return A pointer to the newly created UnrolledList, or NULL on failure.
+ */
+UnrolledList* createUListWithAllocator(const Allocator *allocator);
+
+/**
+ * @brief Checks if the list is empty.
+ * @param list A pointer to the UnrolledList.
+ * @return 1 if the list is empty or NULL, 0 otherwise.
+ */
+int ulistIsEmpty(UnrolledList *list);
+
+/**
+ * @brief Inserts a value at the beginning of the list.
+ * @param list A pointer to the UnrolledList.
+ * @param data The value to insert.
+ * @return LIB_OK on success, or a negative LibStatus on failure.
+ */
+int ulistInsertAtBeginning(UnrolledList *list, int data);
+
+/**
+ * @brief Appends a value at the end of the list in O(1).
+ * @param list A pointer to the UnrolledList.
+ * @param data The value to insert.
+ * @return LIB_OK on success, or a negative LibStatus on failure.
+ */
+int ulistInsertAtEnd(UnrolledList *list, int data);
+
+/**
+ * @brief Inserts a value after the first occurrence of another value.
+ * @param list A pointer to the UnrolledList.
+ * @param data The value to insert.
+ * @param after_value The value after which to insert.
+ * @return 1 if insertion was successful, 0 if after_value was not found or allocation failed.
+ */
+int ulistInsertAfter(UnrolledList *list, int data, int after_value);
+
+/**
+ * @brief Deletes the first occurrence of a value.
+ * @param list A pointer to the UnrolledList.
+ * @param data The value to delete.
+ * @return 1 if deletion was successful, 0 if data was not found.
+ */
+int ulistDeleteValue(UnrolledList *list, int data);
+
+/**
+ * @brief Deletes the value at a specific position (0-indexed).
+ *
+ * Whole nodes are skipped by their count, so reaching the position costs
+ * one step per node rather than one per value.
+ *
+ * @param list A pointer to the UnrolledList.
+ * @param position The position of the value to delete.
+ * @return The deleted value if successful, or -1 if position is invalid.
+ */
+int ulistDeleteAtPosition(UnrolledList *list, int position);
+
+/**
+ * @brief Reads the value at a specific position (0-indexed).
+ * @param list A pointer to the UnrolledList.
+ * @param position The position to read.
+ * @param out Receives the value.
+ * @return LIB_OK on success, LIB_ERR_OUT_OF_RANGE or LIB_ERR_INVALID_ARG on failure.
+ */
+int ulistGet(UnrolledList *list, size_t position, int *out);
+
+/**
+ * @brief Searches for the first occurrence of a value.
+ * @param list A pointer to the UnrolledList.
+ * @param data The value to search for.
+ * @return A pointer to the stored value, or NULL if not found. The pointer
+ *         is valid only until the next insert or delete on the list.
+ */
+int* ulistSearch(UnrolledList *list, int data);
+
+/**
+ * @brief Prints all values in the list from head to tail.
+ * @param list A pointer to the UnrolledList.
+ */
+void printUList(UnrolledList *list);
+
+/**
+ * @brief Returns the current number of values in the list.
+ * @param list A pointer to the UnrolledList.
+ * @return The size of the list.
+ */
+size_t getUListSize(UnrolledList *list);
+
+/**
+ * @brief Deallocates all memory used by the list.
+ * @param list A pointer to the UnrolledList.
+ */
+void destroyUList(UnrolledList *list);
+
+#endif // UNROLLED_LIST_H
@@ -2,17 +2,32 @@
 #define MY_VECTOR_H
 
 #include <stddef.h> // For size_t
+#include "diag.h"   // For LibStatus
+#include "allocator.h" // For Allocator
+#include "stats.h"  // For VectorStats
 
-// Public structure definition for the Vector
-typedef struct {
-    void** data;
+struct VectorMapping; // Private file mapping, see vector_open_mapped()
+
+// Public structure definition for the Vector.
+// Elements are packed back to back in 'data' (capacity * element_size bytes),
+// so vector_get returns an address inside that buffer. Such a pointer stays
+// valid only until the next call that grows the vector.
+typedef struct Vector {
+    char* data;
     size_t size;
     size_t capacity;
     size_t element_size;
+    const Allocator* allocator; // Source of the struct, and of 'data' unless the vector is mapped
+    struct VectorMapping* mapping; // File backing 'data' for vector_open_mapped(), NULL otherwise
+#ifdef MY_C_LIB_STATS
+    VectorStats stats;
+#endif
 } Vector;
 
-// Public function prototypes (the API that users will call)
+// Public function prototypes (the API that users will call).
+// int-returning functions return LIB_OK (0) on success or a negative LibStatus.
 Vector* vector_create(size_t initial_capacity, size_t element_size);
+Vector* vector_create_with_allocator(size_t initial_capacity, size_t element_size, const Allocator* allocator);
 int vector_add(Vector* vec, const void* element);
 void* vector_get(const Vector* vec, int index);
 int vector_set(Vector* vec, int index, const void* element);
@@ -20,4 +35,25 @@ int vector_remove(Vector* vec, int index);
 size_t vector_size(const Vector* vec);
 void vector_destroy(Vector* vec);
 
+// Capacity management and bulk growth.
+int vector_append_n(Vector* vec, const void* src, size_t count); // copies 'count' elements from 'src' with one memcpy
+int vector_reserve(Vector* vec, size_t capacity);                  // grows capacity to at least 'capacity', never shrinks
+int vector_resize(Vector* vec, size_t new_size);                   // new elements are zero-filled
+int vector_shrink_to_fit(Vector* vec);                             // releases unused capacity
+
+// Range edits, each a single memmove.
+int vector_erase_range(Vector* vec, size_t first, size_t last);                 // removes [first, last)
+int vector_insert_n(Vector* vec, size_t index, const void* src, size_t count);  // inserts before 'index'
+int vector_swap_remove(Vector* vec, int index); // O(1) remove that moves the last element into 'index'; does not keep order
+
+// File-backed storage (POSIX only; vector_open_mapped returns NULL elsewhere).
+// The elements live in an mmap'd file after a small header holding the size,
+// capacity and element_size. Growth extends the file and remaps it, so 'data'
+// may move as with any other growth. Reopening maps the existing elements
+// in place with no copying. The header's size is updated by vector_sync and
+// vector_destroy; after a crash the file reopens with the last recorded size.
+// Only one open vector per file at a time (the file is flock'ed).
+Vector* vector_open_mapped(const char* path, size_t element_size); // creates the file or reopens it; NULL if element_size differs
+int vector_sync(Vector* vec);                                      // records the size and msyncs the mapping to disk
+
 #endif // MY_VECTOR_H
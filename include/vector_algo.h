@@ -0,0 +1,31 @@
+#ifndef MY_VECTOR_ALGO_H
+#define MY_VECTOR_ALGO_H
+
+#include <stddef.h> // For size_t
+#include "vector.h" // For Vector
+
+// Sorting and data-parallel loops over a Vector's contiguous storage.
+// They spread work over thread_pool_default() and fall back to the calling
+// thread for small inputs or when no pool could be started. The sorts need a
+// scratch buffer as large as the vector's contents.
+// int-returning functions return LIB_OK or a negative LibStatus.
+
+// Integer key types for vector_sort_by_key
+typedef enum VectorKeyType {
+    VECTOR_KEY_INT32,
+    VECTOR_KEY_UINT32,
+    VECTOR_KEY_INT64,
+    VECTOR_KEY_UINT64
+} VectorKeyType;
+
+// Per-chunk body for vector_parallel_for: 'first' points at element
+// 'start_index', and the chunk covers 'count' consecutive elements.
+// It may call the functions below on other vectors; those nested calls run
+// single-threaded on the chunk's own thread.
+typedef void (*VectorChunkFn)(void* first, size_t start_index, size_t count, void* ctx);
+
+int vector_sort(Vector* vec, int (*compare)(const void*, const void*));             // stable parallel merge sort
+int vector_sort_by_key(Vector* vec, size_t key_offset, VectorKeyType key_type);     // stable parallel radix sort on an integer field
+int vector_parallel_for(Vector* vec, VectorChunkFn fn, void* ctx);                  // chunks run concurrently, in no particular order
+
+#endif // MY_VECTOR_ALGO_H
@@ -0,0 +1,25 @@
+#ifndef MY_VECTOR_OPS_H
+#define MY_VECTOR_OPS_H
+
+#include <stddef.h> // For size_t
+#include <stdint.h> // For int32_t, int64_t
+#include "vector.h" // For Vector
+
+// Search and reduce kernels over a Vector's contiguous storage.
+// They scan 'data' directly with SSE2, or AVX2 when the CPU supports it
+// (checked at run time), and fall back to plain loops elsewhere.
+// The _int32 kernels need element_size == sizeof(int32_t) and the _float ones
+// element_size == sizeof(float); otherwise they return LIB_ERR_INVALID_ARG.
+// Results go through the out parameter; the return value is a LibStatus.
+
+int vector_find_int32(const Vector* vec, int32_t value, size_t* index);      // first match; LIB_ERR_NOT_FOUND if none
+int vector_count_eq_int32(const Vector* vec, int32_t value, size_t* count);
+int vector_sum_int32(const Vector* vec, int64_t* sum);                        // 64-bit sum, cannot overflow below 2^32 elements
+int vector_min_int32(const Vector* vec, int32_t* min);                        // LIB_ERR_OUT_OF_RANGE on an empty vector
+int vector_max_int32(const Vector* vec, int32_t* max);                        // LIB_ERR_OUT_OF_RANGE on an empty vector
+
+int vector_sum_float(const Vector* vec, double* sum);   // accumulates in double; summation order differs from a plain loop
+int vector_min_float(const Vector* vec, float* min);    // result is unspecified if the vector holds NaNs
+int vector_max_float(const Vector* vec, float* max);    // result is unspecified if the vector holds NaNs
+
+#endif // MY_VECTOR_OPS_H
@@ -0,0 +1,25 @@
+#include "allocator.h"
+#include <stdlib.h>
+
+static void* malloc_alloc(void *ctx, size_t size) {
+    (void)ctx;
+    return malloc(size);
+}
+
+static void* malloc_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    (void)ctx;
+    (void)old_size;
+    return realloc(ptr, new_size);
+}
+
+static void malloc_free(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    (void)size;
+    free(ptr);
+}
+
+static const Allocator default_allocator = { malloc_alloc, malloc_realloc, malloc_free, NULL };
+
+const Allocator* allocator_default(void) {
+    return &default_allocator;
+}
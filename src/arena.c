@@ -0,0 +1,174 @@
+#include "arena.h"
+#include "diag_internal.h"
+#include <stddef.h> // For max_align_t
+#include <stdint.h> // For uintptr_t, SIZE_MAX
+#include <stdlib.h>
+#include <string.h>
+
+// Alignment of container memory served through arena_allocator()
+#define ARENA_ALIGN _Alignof(max_align_t)
+// Block header size, rounded so the usable bytes start max_align_t-aligned
+#define ARENA_HEADER ((sizeof(ArenaBlock) + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN)
+
+static inline char* block_data(ArenaBlock *block) {
+    return (char *)block + ARENA_HEADER;
+}
+
+static ArenaBlock* new_block(size_t size) {
+    if (size > SIZE_MAX - ARENA_HEADER) {
+        DIAG_ERROR_MSG("Arena block of %zu bytes is too large.", size);
+        return NULL;
+    }
+    ArenaBlock *block = (ArenaBlock *)malloc(ARENA_HEADER + size);
+    if (block == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate arena block of %zu bytes.", size);
+        return NULL;
+    }
+    block->next = NULL;
+    block->size = size;
+    return block;
+}
+
+// --- Allocator adapter ---
+
+static void* arena_alloc_cb(void *ctx, size_t size) {
+    return arena_alloc((Arena *)ctx, size, ARENA_ALIGN);
+}
+
+static void* arena_realloc_cb(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    Arena *arena = (Arena *)ctx;
+    if (ptr == NULL) {
+        return arena_alloc(arena, new_size, ARENA_ALIGN);
+    }
+    if ((char *)ptr == arena->last) {
+        // Nothing follows it in the block: move the end of the allocation
+        size_t offset = (size_t)((char *)ptr - block_data(arena->current));
+        if (arena->current->size - offset >= new_size) {
+            arena->used = offset + new_size;
+            return ptr;
+        }
+    } else if (new_size <= old_size) {
+        return ptr; // Shrinking elsewhere just leaves the tail unused
+    }
+    void *moved = arena_alloc(arena, new_size, ARENA_ALIGN);
+    if (moved == NULL) {
+        return NULL;
+    }
+    memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    return moved;
+}
+
+static void arena_free_cb(void *ctx, void *ptr, size_t size) {
+    Arena *arena = (Arena *)ctx;
+    (void)size;
+    if (ptr != NULL && (char *)ptr == arena->last) {
+        arena->used = (size_t)((char *)ptr - block_data(arena->current)); // Undo the latest allocation
+        arena->last = NULL;
+    }
+}
+
+// --- Public API ---
+
+Arena* arena_create(size_t block_size) {
+    if (block_size == 0) {
+        block_size = ARENA_DEFAULT_BLOCK_SIZE;
+    }
+    Arena *arena = (Arena *)malloc(sizeof(Arena));
+    if (arena == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate memory for Arena structure.");
+        return NULL;
+    }
+    arena->first = new_block(block_size);
+    if (arena->first == NULL) {
+        free(arena);
+        return NULL;
+    }
+    arena->current = arena->first;
+    arena->used = 0;
+    arena->block_size = block_size;
+    arena->last = NULL;
+    arena->allocator.alloc = arena_alloc_cb;
+    arena->allocator.realloc = arena_realloc_cb;
+    arena->allocator.free = arena_free_cb;
+    arena->allocator.ctx = arena;
+    DIAG_TRACE_MSG("Arena created with %zu-byte blocks.", block_size);
+    return arena;
+}
+
+void* arena_alloc(Arena *arena, size_t size, size_t align) {
+    if (align == 0 || (align & (align - 1)) != 0) {
+        DIAG_ERROR_MSG("Alignment %zu is not a power of two.", align);
+        return NULL;
+    }
+    for (;;) {
+        char *base = block_data(arena->current);
+        uintptr_t cursor = (uintptr_t)(base + arena->used);
+        size_t offset = (size_t)(((cursor + align - 1) & ~(uintptr_t)(align - 1)) - (uintptr_t)base);
+        if (offset <= arena->current->size && arena->current->size - offset >= size) {
+            arena->used = offset + size;
+            arena->last = base + offset;
+            return arena->last;
+        }
+        // Worst-case padding included, so the request fits at any block address
+        if (size > SIZE_MAX - (align - 1)) {
+            DIAG_ERROR_MSG("Arena request of %zu bytes is too large.", size);
+            return NULL;
+        }
+        size_t needed = size + (align - 1);
+        ArenaBlock *next = arena->current->next;
+        if (next == NULL || next->size < needed) {
+            // Splice in a fresh block; a smaller spare stays in the chain for later
+            ArenaBlock *fresh = new_block(needed > arena->block_size ? needed : arena->block_size);
+            if (fresh == NULL) {
+                return NULL;
+            }
+            fresh->next = next;
+            arena->current->next = fresh;
+            next = fresh;
+        }
+        arena->current = next;
+        arena->used = 0;
+    }
+}
+
+ArenaMark arena_mark(const Arena *arena) {
+    ArenaMark mark = { arena->current, arena->used };
+    return mark;
+}
+
+void arena_release(Arena *arena, ArenaMark mark) {
+    arena->current = mark.block;
+    arena->used = mark.used;
+    arena->last = NULL;
+}
+
+void arena_reset(Arena *arena) {
+    arena->current = arena->first;
+    arena->used = 0;
+    arena->last = NULL;
+}
+
+size_t arena_capacity(const Arena *arena) {
+    size_t total = 0;
+    for (const ArenaBlock *block = arena->first; block != NULL; block = block->next) {
+        total += block->size;
+    }
+    return total;
+}
+
+const Allocator* arena_allocator(Arena *arena) {
+    return &arena->allocator;
+}
+
+void arena_destroy(Arena *arena) {
+    if (arena == NULL) {
+        return;
+    }
+    ArenaBlock *block = arena->first;
+    while (block != NULL) {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    free(arena);
+}
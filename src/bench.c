@@ -0,0 +1,979 @@
+// Microbenchmarks for the library's containers and allocators.
+//
+// Every case is repeated several times. Each run prints one JSON object
+// per line with the mean ns/op, p50/p90/p99 over the repetitions and the
+// process's peak RSS. This makes the output easy to diff and to feed
+// into regression checks.
+//
+// Usage: my_c_bench [--reps N] [--filter SUBSTRING] [--quick]
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#include "arena.h"
+#include "concurrent_pool.h"
+#include "linked_list.h"
+#include "mempool.h"
+#include "ring_queue.h"
+#include "skip_list.h"
+#include "typed_vector.h"
+#include "thread_pool.h"
+#include "unrolled_list.h"
+#include "vector.h"
+#include "vector_algo.h"
+#include "vector_ops.h"
+
+#define MAX_REPS 101
+
+typedef struct BenchConfig {
+    int reps;
+    const char *filter;
+    int quick;
+} BenchConfig;
+
+// Parameters of one case, echoed into its JSON line
+typedef struct BenchCase {
+    const char *name;
+    size_t size;         // container size or number of operations per rep
+    size_t element_size; // 0 when not applicable
+    int threads;
+} BenchCase;
+
+// A benchmark body runs one repetition and returns how many operations it timed.
+// 'elapsed_ns' receives the time spent on those operations only.
+typedef size_t (*BenchFn)(const BenchCase *bc, double *elapsed_ns);
+
+static volatile size_t sink; // Keeps results observable so loops are not optimized away
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static long peak_rss_kb(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss; // Kilobytes on Linux
+}
+
+static int compare_double(const void *a, const void *b) {
+    double left = *(const double *)a;
+    double right = *(const double *)b;
+    return (left > right) - (left < right);
+}
+
+static double percentile(const double *sorted, int count, double p) {
+    int index = (int)(p * (count - 1) + 0.5);
+    return sorted[index];
+}
+
+// Simple deterministic generator so every run measures the same access pattern
+static unsigned int rng_state = 12345u;
+static unsigned int next_random(void) {
+    rng_state = rng_state * 1103515245u + 12345u;
+    return rng_state >> 1;
+}
+
+static void run_case(const BenchConfig *cfg, const BenchCase *bc, BenchFn fn) {
+    if (cfg->filter != NULL && strstr(bc->name, cfg->filter) == NULL) {
+        return;
+    }
+    double samples[MAX_REPS];
+    double total_ns = 0.0;
+    size_t total_ops = 0;
+    rng_state = 12345u;
+    fn(bc, &total_ns); // Warm-up repetition, not recorded
+    total_ns = 0.0;
+    for (int rep = 0; rep < cfg->reps; ++rep) {
+        double elapsed = 0.0;
+        size_t ops = fn(bc, &elapsed);
+        samples[rep] = ops > 0 ? elapsed / (double)ops : 0.0;
+        total_ns += elapsed;
+        total_ops += ops;
+    }
+    qsort(samples, (size_t)cfg->reps, sizeof(double), compare_double);
+    printf("{\"bench\":\"%s\",\"size\":%zu,\"element_size\":%zu,\"threads\":%d,\"reps\":%d,"
+           "\"ns_per_op\":%.2f,\"p50\":%.2f,\"p90\":%.2f,\"p99\":%.2f,\"peak_rss_kb\":%ld}\n",
+           bc->name, bc->size, bc->element_size, bc->threads, cfg->reps,
+           total_ops > 0 ? total_ns / (double)total_ops : 0.0,
+           percentile(samples, cfg->reps, 0.50), percentile(samples, cfg->reps, 0.90),
+           percentile(samples, cfg->reps, 0.99), peak_rss_kb());
+    fflush(stdout);
+}
+
+// --- Vector ---
+
+static size_t bench_vector_add(const BenchCase *bc, double *elapsed_ns) {
+    char element[256] = {0};
+    Vector *vec = vector_create(16, bc->element_size);
+    double start = now_ns();
+    for (size_t i = 0; i < bc->size; ++i) {
+        element[0] = (char)i;
+        vector_add(vec, element);
+    }
+    *elapsed_ns = now_ns() - start;
+    sink += vector_size(vec);
+    vector_destroy(vec);
+    return bc->size;
+}
+
+static Vector* filled_vector(size_t count, size_t element_size) {
+    Vector *vec = vector_create(count, element_size);
+    vector_resize(vec, count);
+    return vec;
+}
+
+static size_t bench_vector_get(const BenchCase *bc, double *elapsed_ns) {
+    Vector *vec = filled_vector(bc->size, bc->element_size);
+    size_t sum = 0;
+    double start = now_ns();
+    for (size_t i = 0; i < bc->size; ++i) {
+        sum += *(unsigned char *)vector_get(vec, (int)i);
+    }
+    *elapsed_ns = now_ns() - start;
+    sink += sum;
+    vector_destroy(vec);
+    return bc->size;
+}
+
+static size_t bench_vector_remove(const BenchCase *bc, double *elapsed_ns) {
+    Vector *vec = filled_vector(bc->size, bc->element_size);
+    // Each remove shifts half the vector on average: cap the bytes moved per rep
+    size_t ops = ((size_t)1 << 28) / (bc->size * bc->element_size);
+    ops = ops < 10 ? 10 : (ops > 1000 ? 1000 : ops);
+    double start = now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        vector_remove(vec, (int)(next_random() % vector_size(vec)));
+    }
+    *elapsed_ns = now_ns() - start;
+    vector_destroy(vec);
+    return ops;
+}
+
+// --- Vector scan kernels (int32 elements) ---
+
+static Vector* filled_int32_vector(size_t count) {
+    Vector *vec = vector_create(count, sizeof(int32_t));
+    for (size_t i = 0; i < count; ++i) {
+        int32_t value = (int32_t)(next_random() % 1000000u);
+        vector_add(vec, &value);
+    }
+    return vec;
+}
+
+// Element-by-element search through vector_get, the baseline for the kernels
+static size_t bench_vector_find_get_loop(const BenchCase *bc, double *elapsed_ns) {
+    Vector *vec = filled_int32_vector(bc->size);
+    size_t found = bc->size;
+    double start = now_ns();
+    for (size_t i = 0; i < bc->size; ++i) {
+        if (*(int32_t *)vector_get(vec, (int)i) == -1) {
+            found = i;
+            break;
+        }
+    }
+    *elapsed_ns = now_ns() - start;
+    sink += found;
+    vector_destroy(vec);
+    return bc->size;
+}
+
+static size_t bench_vector_find_int32(const BenchCase *bc, double *elapsed_ns) {
+    Vector *vec = filled_int32_vector(bc->size);
+    size_t index = 0;
+    double start = now_ns();
+    int status = vector_find_int32(vec, -1, &index); // absent, so the whole vector is scanned
+    *elapsed_ns = now_ns() - start;
+    sink += index + (size_t)(status == LIB_ERR_NOT_FOUND);
+    vector_destroy(vec);
+    return bc->size;
+}
+
+static size_t bench_vector_sum_int32(const BenchCase *bc, double *elapsed_ns) {
+    Vector *vec = filled_int32_vector(bc->size);
+    int64_t sum = 0;
+    double start = now_ns();
+    vector_sum_int32(vec, &sum);
+    *elapsed_ns = now_ns() - start;
+    sink += (size_t)sum;
+    vector_destroy(vec);
+    return bc->size;
+}
+
+// --- Vector sorting (int32 elements) ---
+
+static int compare_int32(const void *a, const void *b) {
+    int32_t left = *(const int32_t *)a;
+    int32_t right = *(const int32_t *)b;
+    return (left > right) - (left < right);
+}
+
+// Single-threaded libc sort, the baseline for the library sorts
+static size_t bench_qsort_int32(const BenchCase *bc, double *elapsed_ns) {
+    Vector *vec = filled_int32_vector(bc->size);
+    double start = now_ns();
+    qsort(vec->data, vec->size, sizeof(int32_t), compare_int32);
+    *elapsed_ns = now_ns() - start;
+    sink += (size_t)*(int32_t *)vector_get(vec, 0);
+    vector_destroy(vec);
+    return bc->size;
+}
+
+static size_t bench_vector_sort(const BenchCase *bc, double *elapsed_ns) {
+    Vector *vec = filled_int32_vector(bc->size);
+    double start = now_ns();
+    vector_sort(vec, compare_int32);
+    *elapsed_ns = now_ns() - start;
+    sink += (size_t)*(int32_t *)vector_get(vec, 0);
+    vector_destroy(vec);
+    return bc->size;
+}
+
+static size_t bench_vector_sort_by_key(const BenchCase *bc, double *elapsed_ns) {
+    Vector *vec = filled_int32_vector(bc->size);
+    double start = now_ns();
+    vector_sort_by_key(vec, 0, VECTOR_KEY_INT32);
+    *elapsed_ns = now_ns() - start;
+    sink += (size_t)*(int32_t *)vector_get(vec, 0);
+    vector_destroy(vec);
+    return bc->size;
+}
+
+// --- Typed vector (compile-time element size) ---
+
+DEFINE_VECTOR(int, IntVec)
+
+static size_t bench_int_vec_push(const BenchCase *bc, double *elapsed_ns) {
+    IntVec vec;
+    IntVec_init(&vec, 16);
+    double start = now_ns();
+    for (size_t i = 0; i < bc->size; ++i) {
+        IntVec_push(&vec, (int)i);
+    }
+    *elapsed_ns = now_ns() - start;
+    sink += IntVec_size(&vec);
+    IntVec_free(&vec);
+    return bc->size;
+}
+
+static size_t bench_int_vec_sum(const BenchCase *bc, double *elapsed_ns) {
+    IntVec vec;
+    IntVec_init(&vec, bc->size);
+    for (size_t i = 0; i < bc->size; ++i) {
+        IntVec_push(&vec, (int)i);
+    }
+    int sum = 0;
+    const int *p;
+    double start = now_ns();
+    TYPED_VECTOR_FOREACH(p, &vec) {
+        sum += *p;
+    }
+    *elapsed_ns = now_ns() - start;
+    sink += (size_t)(unsigned int)sum;
+    IntVec_free(&vec);
+    return bc->size;
+}
+
+// --- LinkedList ---
+
+static LinkedList* filled_list(size_t count) {
+    LinkedList *list = createList();
+    for (size_t i = 0; i < count; ++i) {
+        insertAtEnd(list, (int)i);
+    }
+    return list;
+}
+
+static size_t bench_list_build(const BenchCase *bc, double *elapsed_ns) {
+    double start = now_ns();
+    LinkedList *list = filled_list(bc->size);
+    *elapsed_ns = now_ns() - start;
+    sink += getListSize(list);
+    destroyList(list);
+    return bc->size;
+}
+
+static size_t bench_list_search(const BenchCase *bc, double *elapsed_ns) {
+    LinkedList *list = filled_list(bc->size);
+    size_t ops = 1000;
+    size_t found = 0;
+    double start = now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        found += searchList(list, (int)(next_random() % bc->size)) != NULL;
+    }
+    *elapsed_ns = now_ns() - start;
+    sink += found;
+    destroyList(list);
+    return ops;
+}
+
+static size_t bench_list_delete(const BenchCase *bc, double *elapsed_ns) {
+    LinkedList *list = filled_list(bc->size);
+    size_t ops = bc->size < 1000 ? bc->size : 1000;
+    double start = now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        deleteNode(list, (int)(next_random() % bc->size));
+    }
+    *elapsed_ns = now_ns() - start;
+    destroyList(list);
+    return ops;
+}
+
+static size_t bench_list_search_indexed(const BenchCase *bc, double *elapsed_ns) {
+    LinkedList *list = filled_list(bc->size);
+    enableListIndex(list);
+    size_t ops = 1000;
+    size_t found = 0;
+    double start = now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        found += searchList(list, (int)(next_random() % bc->size)) != NULL;
+    }
+    *elapsed_ns = now_ns() - start;
+    sink += found;
+    destroyList(list);
+    return ops;
+}
+
+static size_t bench_list_delete_indexed(const BenchCase *bc, double *elapsed_ns) {
+    LinkedList *list = filled_list(bc->size);
+    enableListIndex(list);
+    size_t ops = bc->size < 1000 ? bc->size : 1000;
+    double start = now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        deleteNode(list, (int)(next_random() % bc->size));
+    }
+    *elapsed_ns = now_ns() - start;
+    destroyList(list);
+    return ops;
+}
+
+static size_t bench_list_from_array(const BenchCase *bc, double *elapsed_ns) {
+    // Kept across runs so the array's own malloc/free does not reshape the heap every time
+    static int *values = NULL;
+    static size_t capacity = 0;
+    if (capacity < bc->size) {
+        free(values);
+        values = (int *)malloc(bc->size * sizeof(int));
+        capacity = bc->size;
+        for (size_t i = 0; i < bc->size; ++i) {
+            values[i] = (int)i;
+        }
+    }
+    double start = now_ns();
+    LinkedList *list = list_from_array(NULL, values, bc->size);
+    *elapsed_ns = now_ns() - start;
+    sink += getListSize(list);
+    destroyList(list);
+    return bc->size;
+}
+
+// Periodic cleanup: drop a random tenth of the values, one deleteNode() per
+// value, or all of them in one list_remove_all_of() pass
+static int* cleanup_values(size_t size, size_t count) {
+    int *values = (int *)malloc(count * sizeof(int));
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = (int)(next_random() % size);
+    }
+    return values;
+}
+
+static size_t bench_list_cleanup_each(const BenchCase *bc, double *elapsed_ns) {
+    LinkedList *list = filled_list(bc->size);
+    size_t count = bc->size / 10 > 0 ? bc->size / 10 : 1;
+    int *values = cleanup_values(bc->size, count);
+    double start = now_ns();
+    for (size_t i = 0; i < count; ++i) {
+        deleteNode(list, values[i]);
+    }
+    *elapsed_ns = now_ns() - start;
+    sink += getListSize(list);
+    destroyList(list);
+    free(values);
+    return count;
+}
+
+static size_t bench_list_cleanup_bulk(const BenchCase *bc, double *elapsed_ns) {
+    LinkedList *list = filled_list(bc->size);
+    size_t count = bc->size / 10 > 0 ? bc->size / 10 : 1;
+    int *values = cleanup_values(bc->size, count);
+    size_t removed = 0;
+    double start = now_ns();
+    list_remove_all_of(list, values, count, &removed);
+    *elapsed_ns = now_ns() - start;
+    sink += removed;
+    destroyList(list);
+    free(values);
+    return count;
+}
+
+static LinkedList* random_list(size_t count) {
+    LinkedList *list = createList();
+    for (size_t i = 0; i < count; ++i) {
+        insertAtEnd(list, (int)next_random());
+    }
+    return list;
+}
+
+// The old way to sort a list: copy the values out, qsort them, rebuild the list
+static size_t bench_list_sort_rebuild(const BenchCase *bc, double *elapsed_ns) {
+    LinkedList *list = random_list(bc->size);
+    double start = now_ns();
+    int *values = (int *)malloc(bc->size * sizeof(int));
+    size_t count = 0;
+    for (Node *node = list->head; node != NULL; node = node->next) {
+        values[count++] = node->data;
+    }
+    qsort(values, count, sizeof(int), compare_int32);
+    LinkedList *sorted = createList();
+    for (size_t i = 0; i < count; ++i) {
+        insertAtEnd(sorted, values[i]);
+    }
+    destroyList(list);
+    free(values);
+    *elapsed_ns = now_ns() - start;
+    sink += getListSize(sorted);
+    destroyList(sorted);
+    return bc->size;
+}
+
+static size_t bench_list_sort(const BenchCase *bc, double *elapsed_ns) {
+    LinkedList *list = random_list(bc->size);
+    double start = now_ns();
+    list_sort(list, NULL);
+    *elapsed_ns = now_ns() - start;
+    sink += (size_t)list->head->data;
+    destroyList(list);
+    return bc->size;
+}
+
+// Records looked up by id: stored inline in the nodes, or malloc'd apart
+// with an int handle in the list (two allocations and two misses each).
+// Both lists hold the ids in the same shuffled order, so the separately
+// allocated records are not laid out in list order.
+typedef struct BenchRecord {
+    uint64_t id;
+    double value;
+    char name[16];
+} BenchRecord;
+
+static size_t* shuffled_ids(size_t count) {
+    size_t *ids = (size_t *)malloc(count * sizeof(size_t));
+    for (size_t i = 0; i < count; ++i) {
+        ids[i] = i;
+    }
+    for (size_t i = count; i > 1; --i) {
+        size_t j = next_random() % i;
+        size_t swap = ids[i - 1];
+        ids[i - 1] = ids[j];
+        ids[j] = swap;
+    }
+    return ids;
+}
+
+static size_t bench_list_records_inline(const BenchCase *bc, double *elapsed_ns) {
+    ListConfig config = { sizeof(BenchRecord), NULL, offsetof(BenchRecord, id), sizeof(uint64_t), NULL, 0 };
+    LinkedList *list = createListWithConfig(&config);
+    size_t *ids = shuffled_ids(bc->size);
+    for (size_t i = 0; i < bc->size; ++i) {
+        BenchRecord record = { ids[i], (double)ids[i], "record" };
+        list_push_back(list, &record);
+    }
+    free(ids);
+    size_t ops = 1000;
+    double total = 0.0;
+    double start = now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        uint64_t id = next_random() % bc->size;
+        BenchRecord *record = (BenchRecord *)list_find(list, &id);
+        total += record != NULL ? record->value : 0.0;
+    }
+    *elapsed_ns = now_ns() - start;
+    sink += (size_t)total;
+    destroyList(list);
+    return ops;
+}
+
+static size_t bench_list_records_handles(const BenchCase *bc, double *elapsed_ns) {
+    BenchRecord **records = (BenchRecord **)malloc(bc->size * sizeof(BenchRecord *));
+    LinkedList *list = createList();
+    for (size_t i = 0; i < bc->size; ++i) {
+        records[i] = (BenchRecord *)malloc(sizeof(BenchRecord));
+        BenchRecord record = { i, (double)i, "record" };
+        *records[i] = record;
+    }
+    size_t *ids = shuffled_ids(bc->size);
+    for (size_t i = 0; i < bc->size; ++i) {
+        insertAtEnd(list, (int)ids[i]);
+    }
+    free(ids);
+    size_t ops = 1000;
+    double total = 0.0;
+    double start = now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        uint64_t id = next_random() % bc->size;
+        for (Node *node = list->head; node != NULL; node = node->next) {
+            if (records[node->data]->id == id) {
+                total += records[node->data]->value;
+                break;
+            }
+        }
+    }
+    *elapsed_ns = now_ns() - start;
+    sink += (size_t)total;
+    destroyList(list);
+    for (size_t i = 0; i < bc->size; ++i) {
+        free(records[i]);
+    }
+    free(records);
+    return ops;
+}
+
+// --- UnrolledList ---
+
+static UnrolledList* filled_ulist(size_t count) {
+    UnrolledList *list = createUList();
+    for (size_t i = 0; i < count; ++i) {
+        ulistInsertAtEnd(list, (int)i);
+    }
+    return list;
+}
+
+static size_t bench_ulist_build(const BenchCase *bc, double *elapsed_ns) {
+    double start = now_ns();
+    UnrolledList *list = filled_ulist(bc->size);
+    *elapsed_ns = now_ns() - start;
+    sink += getUListSize(list);
+    destroyUList(list);
+    return bc->size;
+}
+
+static size_t bench_ulist_search(const BenchCase *bc, double *elapsed_ns) {
+    UnrolledList *list = filled_ulist(bc->size);
+    size_t ops = 1000;
+    size_t found = 0;
+    double start = now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        found += ulistSearch(list, (int)(next_random() % bc->size)) != NULL;
+    }
+    *elapsed_ns = now_ns() - start;
+    sink += found;
+    destroyUList(list);
+    return ops;
+}
+
+static size_t bench_ulist_delete(const BenchCase *bc, double *elapsed_ns) {
+    UnrolledList *list = filled_ulist(bc->size);
+    size_t ops = bc->size < 1000 ? bc->size : 1000;
+    double start = now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        ulistDeleteValue(list, (int)(next_random() % bc->size));
+    }
+    *elapsed_ns = now_ns() - start;
+    destroyUList(list);
+    return ops;
+}
+
+// --- SkipList ---
+
+static size_t bench_skiplist_insert_random(const BenchCase *bc, double *elapsed_ns) {
+    SkipList *list = skiplist_create();
+    double start = now_ns();
+    for (size_t i = 0; i < bc->size; ++i) {
+        skiplist_insert(list, (int)(next_random() % bc->size), NULL);
+    }
+    *elapsed_ns = now_ns() - start;
+    sink += skiplist_size(list);
+    skiplist_destroy(list);
+    return bc->size;
+}
+
+// A time-ordered index: keys arrive non-decreasing and take the append path
+static size_t bench_skiplist_insert_ordered(const BenchCase *bc, double *elapsed_ns) {
+    SkipList *list = skiplist_create();
+    double start = now_ns();
+    for (size_t i = 0; i < bc->size; ++i) {
+        skiplist_insert(list, (int)(i / 4), NULL);
+    }
+    *elapsed_ns = now_ns() - start;
+    sink += skiplist_size(list);
+    skiplist_destroy(list);
+    return bc->size;
+}
+
+static size_t bench_skiplist_search(const BenchCase *bc, double *elapsed_ns) {
+    SkipList *list = skiplist_create();
+    for (size_t i = 0; i < bc->size; ++i) {
+        skiplist_insert(list, (int)i, NULL);
+    }
+    size_t ops = 1000;
+    size_t found = 0;
+    double start = now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        found += skiplist_find(list, (int)(next_random() % bc->size)) != NULL;
+    }
+    *elapsed_ns = now_ns() - start;
+    sink += found;
+    skiplist_destroy(list);
+    return ops;
+}
+
+// --- Per-request scratch: a vector and a list built, then torn down ---
+
+static size_t build_request_scratch(size_t count, const Allocator *allocator) {
+    Vector *vec = vector_create_with_allocator(16, sizeof(int), allocator);
+    LinkedList *list = createListWithAllocator(allocator);
+    for (size_t i = 0; i < count; ++i) {
+        int value = (int)i;
+        vector_add(vec, &value);
+        insertAtEnd(list, value);
+    }
+    return vector_size(vec) + getListSize(list);
+}
+
+static size_t bench_request_malloc(const BenchCase *bc, double *elapsed_ns) {
+    size_t requests = 100;
+    double start = now_ns();
+    for (size_t r = 0; r < requests; ++r) {
+        Vector *vec = vector_create(16, sizeof(int));
+        LinkedList *list = createList();
+        for (size_t i = 0; i < bc->size; ++i) {
+            int value = (int)i;
+            vector_add(vec, &value);
+            insertAtEnd(list, value);
+        }
+        sink += vector_size(vec) + getListSize(list);
+        vector_destroy(vec);
+        destroyList(list);
+    }
+    *elapsed_ns = now_ns() - start;
+    return requests;
+}
+
+static size_t bench_request_arena(const BenchCase *bc, double *elapsed_ns) {
+    size_t requests = 100;
+    Arena *arena = arena_create(0);
+    double start = now_ns();
+    for (size_t r = 0; r < requests; ++r) {
+        sink += build_request_scratch(bc->size, arena_allocator(arena));
+        arena_reset(arena); // Replaces vector_destroy and destroyList
+    }
+    *elapsed_ns = now_ns() - start;
+    arena_destroy(arena);
+    return requests;
+}
+
+// --- Allocators, single thread ---
+
+static size_t bench_pool_alloc_free(const BenchCase *bc, double *elapsed_ns) {
+    void **blocks = (void **)malloc(bc->size * sizeof(void *));
+    MemPool *pool = createPool(bc->size, bc->element_size);
+    double start = now_ns();
+    for (size_t i = 0; i < bc->size; ++i) {
+        blocks[i] = allocate(pool);
+    }
+    for (size_t i = 0; i < bc->size; ++i) {
+        deallocate(pool, blocks[i]);
+    }
+    *elapsed_ns = now_ns() - start;
+    destroyPool(pool);
+    free(blocks);
+    return 2 * bc->size;
+}
+
+static size_t bench_malloc_free(const BenchCase *bc, double *elapsed_ns) {
+    void **blocks = (void **)malloc(bc->size * sizeof(void *));
+    double start = now_ns();
+    for (size_t i = 0; i < bc->size; ++i) {
+        blocks[i] = malloc(bc->element_size);
+    }
+    for (size_t i = 0; i < bc->size; ++i) {
+        free(blocks[i]);
+    }
+    *elapsed_ns = now_ns() - start;
+    free(blocks);
+    return 2 * bc->size;
+}
+
+// --- Allocators, multiple threads ---
+
+typedef struct ThreadWork {
+    const BenchCase *bc;
+    ConcurrentPool *pool; // NULL to use malloc
+} ThreadWork;
+
+static void* alloc_free_worker(void *arg) {
+    ThreadWork *work = (ThreadWork *)arg;
+    enum { BATCH = 64 };
+    void *blocks[BATCH];
+    size_t rounds = work->bc->size / BATCH;
+    for (size_t r = 0; r < rounds; ++r) {
+        for (int i = 0; i < BATCH; ++i) {
+            blocks[i] = work->pool ? concurrentAllocate(work->pool) : malloc(work->bc->element_size);
+        }
+        for (int i = 0; i < BATCH; ++i) {
+            if (work->pool) {
+                concurrentDeallocate(work->pool, blocks[i]);
+            } else {
+                free(blocks[i]);
+            }
+        }
+    }
+    if (work->pool) {
+        concurrentPoolFlushThreadCache(work->pool);
+    }
+    return NULL;
+}
+
+static size_t run_threads(const BenchCase *bc, ConcurrentPool *pool, double *elapsed_ns) {
+    pthread_t threads[64];
+    ThreadWork work = { bc, pool };
+    double start = now_ns();
+    for (int t = 0; t < bc->threads; ++t) {
+        pthread_create(&threads[t], NULL, alloc_free_worker, &work);
+    }
+    for (int t = 0; t < bc->threads; ++t) {
+        pthread_join(threads[t], NULL);
+    }
+    *elapsed_ns = now_ns() - start;
+    return 2 * (bc->size / 64) * 64 * (size_t)bc->threads;
+}
+
+static size_t bench_concurrent_pool_mt(const BenchCase *bc, double *elapsed_ns) {
+    ConcurrentPool *pool = createConcurrentPool((size_t)bc->threads * 256, bc->element_size);
+    size_t ops = run_threads(bc, pool, elapsed_ns);
+    destroyConcurrentPool(pool);
+    return ops;
+}
+
+static size_t bench_malloc_mt(const BenchCase *bc, double *elapsed_ns) {
+    return run_threads(bc, NULL, elapsed_ns);
+}
+
+// --- Work queues, one producer thread handing ints to one consumer ---
+
+typedef struct QueueWork {
+    const BenchCase *bc;
+    RingQueue *queue;      // NULL to use 'list' under 'lock'
+    LinkedList *list;
+    pthread_mutex_t lock;
+    size_t batch;          // Elements per ring_queue_*_batch call, 1 for single operations
+} QueueWork;
+
+static void* queue_producer(void *arg) {
+    QueueWork *work = (QueueWork *)arg;
+    int values[64];
+    for (size_t sent = 0; sent < work->bc->size;) {
+        if (work->queue == NULL) {
+            pthread_mutex_lock(&work->lock);
+            insertAtEnd(work->list, (int)sent);
+            pthread_mutex_unlock(&work->lock);
+            sent++;
+            continue;
+        }
+        size_t count = work->bc->size - sent < work->batch ? work->bc->size - sent : work->batch;
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = (int)(sent + i);
+        }
+        size_t done = work->batch == 1 ? (size_t)ring_queue_enqueue(work->queue, values)
+                                       : ring_queue_enqueue_batch(work->queue, values, count);
+        sent += done;
+        if (done == 0) {
+            sched_yield(); // Full: let the consumer run
+        }
+    }
+    return NULL;
+}
+
+static size_t run_queue(const BenchCase *bc, RingQueueMode mode, size_t batch, int use_list, double *elapsed_ns) {
+    QueueWork work;
+    work.bc = bc;
+    work.queue = use_list ? NULL : ring_queue_create(1024, sizeof(int), mode);
+    work.list = use_list ? createList() : NULL;
+    pthread_mutex_init(&work.lock, NULL);
+    work.batch = batch;
+    int values[64];
+    size_t received = 0;
+    long long checksum = 0;
+    pthread_t producer;
+    double start = now_ns();
+    pthread_create(&producer, NULL, queue_producer, &work);
+    while (received < bc->size) {
+        size_t got = 0;
+        if (use_list) {
+            pthread_mutex_lock(&work.lock);
+            if (getListSize(work.list) > 0) {
+                values[0] = work.list->head->data;
+                deleteAtPosition(work.list, 0);
+                got = 1;
+            }
+            pthread_mutex_unlock(&work.lock);
+        } else if (batch == 1) {
+            got = (size_t)ring_queue_dequeue(work.queue, values);
+        } else {
+            got = ring_queue_dequeue_batch(work.queue, values, batch);
+        }
+        for (size_t i = 0; i < got; ++i) {
+            checksum += values[i];
+        }
+        received += got;
+        if (got == 0) {
+            sched_yield(); // Empty: let the producer run
+        }
+    }
+    pthread_join(producer, NULL);
+    *elapsed_ns = now_ns() - start;
+    sink += (size_t)checksum;
+    ring_queue_destroy(work.queue);
+    if (use_list) {
+        destroyList(work.list);
+    }
+    pthread_mutex_destroy(&work.lock);
+    return bc->size;
+}
+
+static size_t bench_list_queue_locked(const BenchCase *bc, double *elapsed_ns) {
+    return run_queue(bc, RING_QUEUE_SPSC, 1, 1, elapsed_ns);
+}
+
+static size_t bench_ring_queue_spsc(const BenchCase *bc, double *elapsed_ns) {
+    return run_queue(bc, RING_QUEUE_SPSC, 1, 0, elapsed_ns);
+}
+
+static size_t bench_ring_queue_spsc_batch(const BenchCase *bc, double *elapsed_ns) {
+    return run_queue(bc, RING_QUEUE_SPSC, 32, 0, elapsed_ns);
+}
+
+static size_t bench_ring_queue_mpmc(const BenchCase *bc, double *elapsed_ns) {
+    return run_queue(bc, RING_QUEUE_MPMC, 1, 0, elapsed_ns);
+}
+
+int main(int argc, char **argv) {
+    BenchConfig cfg = { 15, NULL, 0 };
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            cfg.reps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            cfg.filter = argv[++i];
+        } else if (strcmp(argv[i], "--quick") == 0) {
+            cfg.quick = 1;
+        } else {
+            fprintf(stderr, "Usage: %s [--reps N] [--filter SUBSTRING] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (cfg.reps < 1 || cfg.reps > MAX_REPS) {
+        fprintf(stderr, "--reps must be between 1 and %d\n", MAX_REPS);
+        return 1;
+    }
+
+    const size_t vector_sizes[] = { 1000, 100000, 1000000 };
+    const size_t element_sizes[] = { 4, 16, 64 };
+    const size_t list_sizes[] = { 1000, 10000, 100000 };
+    const int thread_counts[] = { 1, 2, 4, 8 };
+    size_t n_vector = cfg.quick ? 2 : 3;
+    size_t n_list = cfg.quick ? 2 : 3;
+
+    for (size_t s = 0; s < n_vector; ++s) {
+        for (size_t e = 0; e < 3; ++e) {
+            BenchCase add = { "vector_add", vector_sizes[s], element_sizes[e], 1 };
+            BenchCase get = { "vector_get", vector_sizes[s], element_sizes[e], 1 };
+            BenchCase rem = { "vector_remove", vector_sizes[s], element_sizes[e], 1 };
+            run_case(&cfg, &add, bench_vector_add);
+            run_case(&cfg, &get, bench_vector_get);
+            run_case(&cfg, &rem, bench_vector_remove);
+        }
+        BenchCase scan = { "vector_find_get_loop", vector_sizes[s], sizeof(int32_t), 1 };
+        BenchCase find = { "vector_find_int32", vector_sizes[s], sizeof(int32_t), 1 };
+        BenchCase total = { "vector_sum_int32", vector_sizes[s], sizeof(int32_t), 1 };
+        run_case(&cfg, &scan, bench_vector_find_get_loop);
+        run_case(&cfg, &find, bench_vector_find_int32);
+        run_case(&cfg, &total, bench_vector_sum_int32);
+        int workers = (int)thread_pool_concurrency(thread_pool_default());
+        BenchCase libc_sort = { "qsort_int32", vector_sizes[s], sizeof(int32_t), 1 };
+        BenchCase merge_sort = { "vector_sort", vector_sizes[s], sizeof(int32_t), workers };
+        BenchCase radix_sort = { "vector_sort_by_key", vector_sizes[s], sizeof(int32_t), workers };
+        run_case(&cfg, &libc_sort, bench_qsort_int32);
+        run_case(&cfg, &merge_sort, bench_vector_sort);
+        run_case(&cfg, &radix_sort, bench_vector_sort_by_key);
+        BenchCase push = { "int_vec_push", vector_sizes[s], sizeof(int), 1 };
+        BenchCase sum = { "int_vec_sum", vector_sizes[s], sizeof(int), 1 };
+        run_case(&cfg, &push, bench_int_vec_push);
+        run_case(&cfg, &sum, bench_int_vec_sum);
+    }
+
+    for (size_t s = 0; s < n_list; ++s) {
+        BenchCase build = { "list_build", list_sizes[s], sizeof(int), 1 };
+        BenchCase search = { "list_search", list_sizes[s], sizeof(int), 1 };
+        BenchCase del = { "list_delete", list_sizes[s], sizeof(int), 1 };
+        run_case(&cfg, &build, bench_list_build);
+        run_case(&cfg, &search, bench_list_search);
+        run_case(&cfg, &del, bench_list_delete);
+        BenchCase isearch = { "list_search_indexed", list_sizes[s], sizeof(int), 1 };
+        BenchCase idel = { "list_delete_indexed", list_sizes[s], sizeof(int), 1 };
+        run_case(&cfg, &isearch, bench_list_search_indexed);
+        run_case(&cfg, &idel, bench_list_delete_indexed);
+        BenchCase from_array = { "list_from_array", list_sizes[s], sizeof(int), 1 };
+        BenchCase cleanup_each = { "list_cleanup_each", list_sizes[s], sizeof(int), 1 };
+        BenchCase cleanup_bulk = { "list_cleanup_bulk", list_sizes[s], sizeof(int), 1 };
+        run_case(&cfg, &from_array, bench_list_from_array);
+        run_case(&cfg, &cleanup_each, bench_list_cleanup_each);
+        run_case(&cfg, &cleanup_bulk, bench_list_cleanup_bulk);
+        BenchCase sort_rebuild = { "list_sort_rebuild", list_sizes[s], sizeof(int), 1 };
+        BenchCase sort_inplace = { "list_sort", list_sizes[s], sizeof(int), 1 };
+        run_case(&cfg, &sort_rebuild, bench_list_sort_rebuild);
+        run_case(&cfg, &sort_inplace, bench_list_sort);
+        BenchCase inline_records = { "list_records_inline", list_sizes[s], sizeof(BenchRecord), 1 };
+        BenchCase handle_records = { "list_records_handles", list_sizes[s], sizeof(BenchRecord), 1 };
+        run_case(&cfg, &inline_records, bench_list_records_inline);
+        run_case(&cfg, &handle_records, bench_list_records_handles);
+        BenchCase ubuild = { "ulist_build", list_sizes[s], sizeof(int), 1 };
+        BenchCase usearch = { "ulist_search", list_sizes[s], sizeof(int), 1 };
+        BenchCase udel = { "ulist_delete", list_sizes[s], sizeof(int), 1 };
+        run_case(&cfg, &ubuild, bench_ulist_build);
+        run_case(&cfg, &usearch, bench_ulist_search);
+        run_case(&cfg, &udel, bench_ulist_delete);
+        BenchCase sinsert = { "skiplist_insert_random", list_sizes[s], sizeof(int), 1 };
+        BenchCase sappend = { "skiplist_insert_ordered", list_sizes[s], sizeof(int), 1 };
+        BenchCase ssearch = { "skiplist_search", list_sizes[s], sizeof(int), 1 };
+        run_case(&cfg, &sinsert, bench_skiplist_insert_random);
+        run_case(&cfg, &sappend, bench_skiplist_insert_ordered);
+        run_case(&cfg, &ssearch, bench_skiplist_search);
+    }
+
+    for (size_t s = 0; s < n_list; ++s) {
+        BenchCase plain = { "request_malloc", list_sizes[s], sizeof(int), 1 };
+        BenchCase arena = { "request_arena", list_sizes[s], sizeof(int), 1 };
+        run_case(&cfg, &plain, bench_request_malloc);
+        run_case(&cfg, &arena, bench_request_arena);
+    }
+
+    for (size_t e = 0; e < 3; ++e) {
+        BenchCase pool = { "pool_alloc_free", 100000, element_sizes[e], 1 };
+        BenchCase sys = { "malloc_free", 100000, element_sizes[e], 1 };
+        run_case(&cfg, &pool, bench_pool_alloc_free);
+        run_case(&cfg, &sys, bench_malloc_free);
+    }
+
+    for (size_t t = 0; t < (cfg.quick ? 2u : 4u); ++t) {
+        BenchCase pool = { "concurrent_pool_alloc_free_mt", 100000, 32, thread_counts[t] };
+        BenchCase sys = { "malloc_free_mt", 100000, 32, thread_counts[t] };
+        run_case(&cfg, &pool, bench_concurrent_pool_mt);
+        run_case(&cfg, &sys, bench_malloc_mt);
+    }
+
+    BenchCase list_queue = { "list_queue_locked", 100000, sizeof(int), 2 };
+    BenchCase spsc = { "ring_queue_spsc", 100000, sizeof(int), 2 };
+    BenchCase spsc_batch = { "ring_queue_spsc_batch", 100000, sizeof(int), 2 };
+    BenchCase mpmc = { "ring_queue_mpmc", 100000, sizeof(int), 2 };
+    run_case(&cfg, &list_queue, bench_list_queue_locked);
+    run_case(&cfg, &spsc, bench_ring_queue_spsc);
+    run_case(&cfg, &spsc_batch, bench_ring_queue_spsc_batch);
+    run_case(&cfg, &mpmc, bench_ring_queue_mpmc);
+    return 0;
+}
@@ -0,0 +1,240 @@
+#include "concurrent_pool.h"
+#include "diag_internal.h"
+#include <stdlib.h>
+
+#define MAGAZINE_BATCH (CONCURRENT_POOL_MAGAZINE_SIZE / 2)
+
+// Helpers to pack and unpack the tagged head word
+static inline uint32_t head_index(uint64_t head) { return (uint32_t)head; }
+static inline uint32_t head_tag(uint64_t head) { return (uint32_t)(head >> 32); }
+static inline uint64_t make_head(uint32_t tag, uint32_t index) {
+    return ((uint64_t)tag << 32) | index;
+}
+
+// A free block stores the (index + 1) of the next free block in its first word.
+// It is read racily by poppers whose CAS will then fail, hence the atomic type.
+static inline _Atomic uint32_t* block_link(ConcurrentPool *pool, uint32_t index) {
+    return (_Atomic uint32_t *)(pool->buffer + (size_t)(index - 1) * pool->block_size);
+}
+
+static inline uint32_t block_index(ConcurrentPool *pool, void *block) {
+    return (uint32_t)(((char *)block - pool->buffer) / pool->block_size) + 1;
+}
+
+// Pushes an already linked chain [first .. last] onto the shared free list
+static void push_chain(ConcurrentPool *pool, uint32_t first, uint32_t last) {
+    uint64_t old_head = atomic_load_explicit(&pool->free_head, memory_order_relaxed);
+    uint64_t new_head;
+    do {
+        atomic_store_explicit(block_link(pool, last), head_index(old_head), memory_order_relaxed);
+        new_head = make_head(head_tag(old_head) + 1, first);
+    } while (!atomic_compare_exchange_weak_explicit(&pool->free_head, &old_head, new_head,
+                                                    memory_order_release, memory_order_relaxed));
+}
+
+// Pops up to 'max' blocks with one CAS. Returns the number written to 'out'.
+static size_t pop_batch(ConcurrentPool *pool, void **out, size_t max) {
+    uint64_t old_head = atomic_load_explicit(&pool->free_head, memory_order_acquire);
+    for (;;) {
+        uint32_t first = head_index(old_head);
+        if (first == 0) {
+            return 0; // Shared list is empty
+        }
+        // Walk up to 'max' links. A concurrent pop can make these reads stale,
+        // but then the tag has moved and the CAS below fails and retries.
+        size_t taken = 0;
+        uint32_t cursor = first;
+        while (cursor != 0 && cursor <= pool->num_blocks && taken < max) {
+            out[taken++] = pool->buffer + (size_t)(cursor - 1) * pool->block_size;
+            cursor = atomic_load_explicit(block_link(pool, cursor), memory_order_relaxed);
+        }
+        if (cursor > pool->num_blocks) {
+            // Torn read of a block that was reallocated meanwhile; reload and retry
+            old_head = atomic_load_explicit(&pool->free_head, memory_order_acquire);
+            continue;
+        }
+        uint64_t new_head = make_head(head_tag(old_head) + 1, cursor);
+        if (atomic_compare_exchange_weak_explicit(&pool->free_head, &old_head, new_head,
+                                                  memory_order_acquire, memory_order_acquire)) {
+            return taken;
+        }
+    }
+}
+
+// Returns 'count' blocks from the top of the magazine to the shared list
+static void flush_magazine(PoolMagazine *mag, size_t count) {
+    ConcurrentPool *pool = mag->pool;
+    if (count == 0) {
+        return;
+    }
+    size_t start = mag->count - count;
+    uint32_t first = block_index(pool, mag->blocks[start]);
+    uint32_t prev = first;
+    for (size_t i = start + 1; i < mag->count; ++i) {
+        uint32_t index = block_index(pool, mag->blocks[i]);
+        atomic_store_explicit(block_link(pool, prev), index, memory_order_relaxed);
+        prev = index;
+    }
+    push_chain(pool, first, prev);
+    mag->count = start;
+}
+
+static void unregister_magazine(ConcurrentPool *pool, PoolMagazine *mag) {
+    pthread_mutex_lock(&pool->registry_lock);
+    PoolMagazine **link = &pool->magazines;
+    while (*link != NULL && *link != mag) {
+        link = &(*link)->next_registered;
+    }
+    if (*link == mag) {
+        *link = mag->next_registered;
+    }
+    pthread_mutex_unlock(&pool->registry_lock);
+}
+
+// pthread key destructor: runs when a thread that used the pool exits
+static void release_magazine(void *arg) {
+    PoolMagazine *mag = (PoolMagazine *)arg;
+    flush_magazine(mag, mag->count);
+    unregister_magazine(mag->pool, mag);
+    free(mag);
+}
+
+static PoolMagazine* thread_magazine(ConcurrentPool *pool) {
+    PoolMagazine *mag = (PoolMagazine *)pthread_getspecific(pool->magazine_key);
+    if (mag != NULL) {
+        return mag;
+    }
+    mag = (PoolMagazine *)malloc(sizeof(PoolMagazine));
+    if (mag == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate memory for pool magazine.");
+        return NULL;
+    }
+    mag->pool = pool;
+    mag->count = 0;
+    pthread_mutex_lock(&pool->registry_lock);
+    mag->next_registered = pool->magazines;
+    pool->magazines = mag;
+    pthread_mutex_unlock(&pool->registry_lock);
+    if (pthread_setspecific(pool->magazine_key, mag) != 0) {
+        unregister_magazine(pool, mag);
+        free(mag);
+        return NULL;
+    }
+    return mag;
+}
+
+ConcurrentPool* createConcurrentPool(size_t num_blocks, size_t block_size) {
+    if (num_blocks == 0 || num_blocks >= UINT32_MAX || block_size == 0) {
+        DIAG_ERROR_MSG("Block count must be in [1, UINT32_MAX) and block size non-zero.");
+        return NULL;
+    }
+    // Blocks must hold the 32-bit link and stay pointer-aligned
+    size_t align = sizeof(void *);
+    size_t effective_block_size = block_size > sizeof(uint32_t) ? block_size : sizeof(uint32_t);
+    effective_block_size = (effective_block_size + align - 1) & ~(align - 1);
+    if (num_blocks > SIZE_MAX / effective_block_size) {
+        return NULL;
+    }
+
+    ConcurrentPool *pool = (ConcurrentPool *)aligned_alloc(64, (sizeof(ConcurrentPool) + 63) & ~(size_t)63);
+    if (pool == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate memory for ConcurrentPool structure.");
+        return NULL;
+    }
+    pool->block_size = effective_block_size;
+    pool->num_blocks = num_blocks;
+    pool->magazines = NULL;
+    pool->buffer = (char *)malloc(num_blocks * effective_block_size);
+    if (pool->buffer == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate memory for concurrent pool buffer.");
+        free(pool);
+        return NULL;
+    }
+    if (pthread_key_create(&pool->magazine_key, release_magazine) != 0) {
+        free(pool->buffer);
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->registry_lock, NULL);
+
+    // Link every block to its successor; the pool is not shared yet
+    for (uint32_t i = 1; i < (uint32_t)num_blocks; ++i) {
+        atomic_store_explicit(block_link(pool, i), i + 1, memory_order_relaxed);
+    }
+    atomic_store_explicit(block_link(pool, (uint32_t)num_blocks), 0, memory_order_relaxed);
+    atomic_store_explicit(&pool->free_head, make_head(0, 1), memory_order_release);
+
+    DIAG_TRACE_MSG("Concurrent pool created with %zu blocks of size %zu", num_blocks, effective_block_size);
+    return pool;
+}
+
+void* concurrentAllocate(ConcurrentPool *pool) {
+    if (pool == NULL) {
+        return NULL;
+    }
+    PoolMagazine *mag = thread_magazine(pool);
+    if (mag == NULL) {
+        // No magazine for this thread: take one block straight from the shared list
+        void *block = NULL;
+        if (pop_batch(pool, &block, 1) == 0) {
+            DIAG_TRACE_MSG("Concurrent pool exhausted.");
+            return NULL;
+        }
+        return block;
+    }
+    if (mag->count == 0) {
+        mag->count = pop_batch(pool, mag->blocks, MAGAZINE_BATCH);
+        if (mag->count == 0) {
+            DIAG_TRACE_MSG("Concurrent pool exhausted.");
+            return NULL;
+        }
+    }
+    return mag->blocks[--mag->count];
+}
+
+void concurrentDeallocate(ConcurrentPool *pool, void *ptr) {
+    if (pool == NULL || ptr == NULL) {
+        return; // No-op if pool or pointer is invalid
+    }
+    PoolMagazine *mag = thread_magazine(pool);
+    if (mag == NULL) {
+        // No magazine for this thread: hand the block straight to the shared list
+        uint32_t index = block_index(pool, ptr);
+        push_chain(pool, index, index);
+        return;
+    }
+    if (mag->count == CONCURRENT_POOL_MAGAZINE_SIZE) {
+        flush_magazine(mag, MAGAZINE_BATCH);
+    }
+    mag->blocks[mag->count++] = ptr;
+}
+
+void concurrentPoolFlushThreadCache(ConcurrentPool *pool) {
+    if (pool == NULL) {
+        return;
+    }
+    PoolMagazine *mag = (PoolMagazine *)pthread_getspecific(pool->magazine_key);
+    if (mag != NULL) {
+        flush_magazine(mag, mag->count);
+    }
+}
+
+void destroyConcurrentPool(ConcurrentPool *pool) {
+    if (pool == NULL) {
+        return; // No-op
+    }
+    pthread_key_delete(pool->magazine_key);
+    PoolMagazine *mag = pool->magazines;
+    while (mag != NULL) {
+        PoolMagazine *next_mag = mag->next_registered;
+        free(mag);
+        mag = next_mag;
+    }
+    pool->magazines = NULL;
+    pthread_mutex_destroy(&pool->registry_lock);
+    free(pool->buffer);
+    pool->buffer = NULL;
+    free(pool);
+
+    DIAG_TRACE_MSG("Concurrent pool destroyed.");
+}
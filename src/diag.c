@@ -0,0 +1,51 @@
+#include "diag_internal.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+#ifdef MY_C_LIB_DIAGNOSTICS
+static DiagTraceHook trace_hook = NULL;
+static void *trace_hook_ctx = NULL;
+#endif
+
+const char* lib_status_str(int status) {
+    switch (status) {
+        case LIB_OK:               return "ok";
+        case LIB_ERR_INVALID_ARG:  return "invalid argument";
+        case LIB_ERR_OUT_OF_RANGE: return "out of range";
+        case LIB_ERR_NO_MEMORY:    return "out of memory";
+        case LIB_ERR_NOT_FOUND:    return "not found";
+        case LIB_ERR_EXHAUSTED:    return "exhausted";
+        case LIB_ERR_IO:           return "I/O error";
+        case LIB_ERR_CORRUPT:      return "corrupt data";
+        default:                   return "unknown status";
+    }
+}
+
+void diag_set_trace_hook(DiagTraceHook hook, void *ctx) {
+#ifdef MY_C_LIB_DIAGNOSTICS
+    trace_hook = hook;
+    trace_hook_ctx = ctx;
+#else
+    (void)hook;
+    (void)ctx;
+#endif
+}
+
+#ifdef MY_C_LIB_DIAGNOSTICS
+void diag_emit(DiagLevel level, const char *func, const char *fmt, ...) {
+    if (trace_hook == NULL && level != DIAG_ERROR) {
+        return; // Trace messages are only formatted when someone listens
+    }
+    char message[256];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(message, sizeof(message), fmt, args);
+    va_end(args);
+
+    if (trace_hook != NULL) {
+        trace_hook(level, func, message, trace_hook_ctx);
+    } else {
+        fprintf(stderr, "%s: %s\n", func, message);
+    }
+}
+#endif
@@ -0,0 +1,18 @@
+#ifndef DIAG_INTERNAL_H
+#define DIAG_INTERNAL_H
+
+#include "diag.h"
+
+// Library-private logging macros. With MY_C_LIB_DIAGNOSTICS undefined they
+// expand to nothing and their arguments are never evaluated, so release
+// builds carry no stdio on the hot paths.
+#ifdef MY_C_LIB_DIAGNOSTICS
+void diag_emit(DiagLevel level, const char *func, const char *fmt, ...);
+#define DIAG_TRACE_MSG(...) diag_emit(DIAG_TRACE, __func__, __VA_ARGS__)
+#define DIAG_ERROR_MSG(...) diag_emit(DIAG_ERROR, __func__, __VA_ARGS__)
+#else
+#define DIAG_TRACE_MSG(...) ((void)0)
+#define DIAG_ERROR_MSG(...) ((void)0)
+#endif
+
+#endif // DIAG_INTERNAL_H
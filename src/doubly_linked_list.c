@@ -0,0 +1,243 @@
+#include "doubly_linked_list.h"
+#include "diag_internal.h" // For DIAG_* logging macros
+#include <stdio.h>  // For printf in printDList
+#include <stdlib.h> // For NULL
+
+// Helper function to get node memory from the list's pool, or its allocator without one
+static DNode* allocateDNode(DoublyLinkedList *list) {
+    if (list->pool == NULL) {
+        return (DNode *)list->allocator->alloc(list->allocator->ctx, sizeof(DNode));
+    }
+    return (DNode *)allocate(list->pool); // Grows per the pool's own policy
+}
+
+// Helper function to return a node to wherever it came from
+static void freeDNode(DoublyLinkedList *list, DNode *node) {
+    if (list->pool == NULL) {
+        list->allocator->free(list->allocator->ctx, node, sizeof(DNode));
+    } else {
+        deallocate(list->pool, node);
+    }
+}
+
+// Helper function to create a detached node
+static DNode* createDNode(DoublyLinkedList *list, int data) {
+    DNode *newNode = allocateDNode(list);
+    if (newNode == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate memory for new doubly linked node.");
+        return NULL;
+    }
+    newNode->data = data;
+    newNode->prev = NULL;
+    newNode->next = NULL;
+    return newNode;
+}
+
+// Helper function to detach a node from its neighbours without freeing it
+static void unlinkDNode(DoublyLinkedList *list, DNode *node) {
+    if (node->prev != NULL) {
+        node->prev->next = node->next;
+    } else {
+        list->head = node->next;
+    }
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    } else {
+        list->tail = node->prev;
+    }
+    node->prev = NULL;
+    node->next = NULL;
+}
+
+// Helper function to link a detached node in front of the head
+static void linkDNodeFront(DoublyLinkedList *list, DNode *node) {
+    node->prev = NULL;
+    node->next = list->head;
+    if (list->head != NULL) {
+        list->head->prev = node;
+    } else {
+        list->tail = node;
+    }
+    list->head = node;
+}
+
+DoublyLinkedList* createDList(void) {
+    return createDListWithAllocator(allocator_default());
+}
+
+DoublyLinkedList* createDListWithAllocator(const Allocator *allocator) {
+    if (allocator == NULL) {
+        DIAG_ERROR_MSG("Allocator is NULL.");
+        return NULL;
+    }
+    DoublyLinkedList *list = (DoublyLinkedList *)allocator->alloc(allocator->ctx, sizeof(DoublyLinkedList));
+    if (list == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate memory for DoublyLinkedList.");
+        return NULL;
+    }
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    list->pool = NULL;
+    list->allocator = allocator;
+    return list;
+}
+
+DoublyLinkedList* createDListWithPool(MemPool *pool) {
+    if (pool == NULL || pool->block_size < sizeof(DNode)) {
+        DIAG_ERROR_MSG("Pool is NULL or its blocks are too small for a DNode.");
+        return NULL;
+    }
+    DoublyLinkedList *list = createDList();
+    if (list != NULL) {
+        list->pool = pool;
+    }
+    return list;
+}
+
+DNode* dlistInsertAtBeginning(DoublyLinkedList *list, int data) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("List is NULL.");
+        return NULL;
+    }
+    DNode *newNode = createDNode(list, data);
+    if (newNode == NULL) {
+        return NULL;
+    }
+    linkDNodeFront(list, newNode);
+    list->size++;
+    return newNode;
+}
+
+DNode* dlistInsertAtEnd(DoublyLinkedList *list, int data) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("List is NULL.");
+        return NULL;
+    }
+    DNode *newNode = createDNode(list, data);
+    if (newNode == NULL) {
+        return NULL;
+    }
+    newNode->prev = list->tail;
+    if (list->tail != NULL) {
+        list->tail->next = newNode;
+    } else {
+        list->head = newNode;
+    }
+    list->tail = newNode;
+    list->size++;
+    return newNode;
+}
+
+DNode* dlistInsertAfterNode(DoublyLinkedList *list, DNode *node, int data) {
+    if (list == NULL || node == NULL) {
+        DIAG_ERROR_MSG("List or node is NULL.");
+        return NULL;
+    }
+    DNode *newNode = createDNode(list, data);
+    if (newNode == NULL) {
+        return NULL;
+    }
+    newNode->prev = node;
+    newNode->next = node->next;
+    if (node->next != NULL) {
+        node->next->prev = newNode;
+    } else {
+        list->tail = newNode;
+    }
+    node->next = newNode;
+    list->size++;
+    return newNode;
+}
+
+DNode* dlistSearch(DoublyLinkedList *list, int data) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("List is NULL.");
+        return NULL;
+    }
+    DNode *current = list->head;
+    while (current != NULL) {
+        if (current->data == data) {
+            return current; // Found the data
+        }
+        current = current->next;
+    }
+    return NULL; // Data not found
+}
+
+int dlistRemoveNode(DoublyLinkedList *list, DNode *node) {
+    if (list == NULL || node == NULL) {
+        return 0;
+    }
+    unlinkDNode(list, node);
+    freeDNode(list, node);
+    list->size--;
+    return 1;
+}
+
+void dlistMoveToFront(DoublyLinkedList *list, DNode *node) {
+    if (list == NULL || node == NULL || list->head == node) {
+        return; // Nothing to do
+    }
+    unlinkDNode(list, node);
+    linkDNodeFront(list, node);
+}
+
+int dlistPopFront(DoublyLinkedList *list, int *out) {
+    if (list == NULL || list->head == NULL) {
+        return 0;
+    }
+    if (out != NULL) {
+        *out = list->head->data;
+    }
+    return dlistRemoveNode(list, list->head);
+}
+
+int dlistPopBack(DoublyLinkedList *list, int *out) {
+    if (list == NULL || list->tail == NULL) {
+        return 0;
+    }
+    if (out != NULL) {
+        *out = list->tail->data;
+    }
+    return dlistRemoveNode(list, list->tail);
+}
+
+void printDList(DoublyLinkedList *list) {
+    if (list == NULL) {
+        printf("List is NULL.\n");
+        return;
+    }
+    if (list->head == NULL) {
+        printf("List is empty.\n");
+        return;
+    }
+    DNode *current = list->head;
+    printf("List elements (%zu): NULL <-> ", list->size);
+    while (current != NULL) {
+        printf("%d <-> ", current->data);
+        current = current->next;
+    }
+    printf("NULL\n");
+}
+
+size_t getDListSize(DoublyLinkedList *list) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("List is NULL.");
+        return 0;
+    }
+    return list->size;
+}
+
+void destroyDList(DoublyLinkedList *list) {
+    if (list == NULL) {
+        return; // Nothing to destroy
+    }
+    DNode *current = list->head;
+    while (current != NULL) {
+        DNode *next_node = current->next; // Store next node before freeing current
+        freeDNode(list, current);
+        current = next_node;
+    }
+    list->allocator->free(list->allocator->ctx, list, sizeof(DoublyLinkedList)); // Free the DoublyLinkedList structure itself
+}
@@ -1,195 +1,1090 @@
 // list.c
 #include "linked_list.h" // Include our own header file
-#include <stdio.h>  // For printf
-#include <stdlib.h> // For malloc, free
+#include "diag_internal.h" // For DIAG_* logging macros
+#include "stats_internal.h" // For STATS_* counters
+#include "list_index_internal.h" // For the optional value index
+#include <stdio.h>  // For printf in printList
+#include <stdlib.h> // For NULL
+#include <stdint.h> // For uint32_t, uint64_t, SIZE_MAX
+#include <string.h> // For memcpy, memcmp
 
-// Helper function to create a new node
-static Node* createNode(int data) {
-    Node *newNode = (Node *)malloc(sizeof(Node));
+_Static_assert(offsetof(Node, data) == offsetof(ListNode, payload), "Node must be a ListNode with an int payload");
+_Static_assert(offsetof(Node, next) == offsetof(FreeNode, next), "A chain of nodes must also be a pool free list");
+
+// Helper function to get node memory from the list's pool, or its allocator without one
+static Node* allocateNode(LinkedList *list) {
+    if (list->pool == NULL) {
+        return (Node *)list->allocator->alloc(list->allocator->ctx, list->node_size);
+    }
+    return (Node *)allocate(list->pool); // Grows per the pool's own policy
+}
+
+// Helper function to return a node to wherever it came from
+static void freeNode(LinkedList *list, Node *node) {
+    STATS_INC(list, node_frees);
+    if (list->pool == NULL) {
+        list->allocator->free(list->allocator->ctx, node, list->node_size);
+    } else {
+        deallocate(list->pool, node);
+    }
+}
+
+// Frees 'count' nodes chained through 'next' from 'first' to 'last' (NULL-terminated)
+static void freeChain(LinkedList *list, Node *first, Node *last, size_t count) {
+    if (first == NULL) {
+        return;
+    }
+    STATS_ADD(list, node_frees, count);
+    if (list->pool != NULL) {
+        deallocateChain(list->pool, first, last, count); // The chain already is a free list
+        return;
+    }
+    while (first != NULL) {
+        Node *next = first->next;
+        list->allocator->free(list->allocator->ctx, first, list->node_size);
+        first = next;
+    }
+}
+
+// Copies a payload; int payloads get an inlined fixed-size copy
+static inline void copyPayload(void *dst, const void *src, size_t size) {
+    if (size == sizeof(int)) {
+        memcpy(dst, src, sizeof(int));
+    } else {
+        memcpy(dst, src, size);
+    }
+}
+
+// Helper function to create a new node holding a copy of 'payload'
+static inline Node* createNode(LinkedList *list, const void *payload) {
+    Node *newNode = allocateNode(list);
     if (newNode == NULL) {
-        perror("Failed to allocate memory for new node");
-        exit(EXIT_FAILURE); // Or handle error gracefully
+        DIAG_ERROR_MSG("Failed to allocate memory for new node.");
+        return NULL;
     }
-    newNode->data = data;
+    copyPayload(list_payload(newNode), payload, list->payload_size);
     newNode->next = NULL;
+    STATS_INC(list, node_allocations);
+    STATS_ADD(list, bytes_allocated, list->node_size);
     return newNode;
 }
 
+// Start of the key bytes inside a node's payload
+static inline const unsigned char* nodeKey(const LinkedList *list, Node *node) {
+    return (const unsigned char *)list_payload(node) + list->key_offset;
+}
+
+// Zero-extends key bytes (key_size <= 8) into the hash index's key type
+static inline uint64_t indexKey(const LinkedList *list, const void *key) {
+    if (list->key_size == sizeof(uint32_t)) {
+        uint32_t bits;
+        memcpy(&bits, key, sizeof(bits));
+        return bits;
+    }
+    uint64_t bits = 0;
+    memcpy(&bits, key, list->key_size);
+    return bits;
+}
+
+static inline uint64_t nodeIndexKey(const LinkedList *list, Node *node) {
+    return indexKey(list, nodeKey(list, node));
+}
+
+// Walks the list for the first node matching 'key'; see findNode().
+// Key bytes of 4 or 8 are compared as one integer instead of through memcmp.
+static Node* scanForKey(LinkedList *list, const void *key, Node **prev_out) {
+    Node *prev = NULL;
+    Node *current = list->head;
+    if (list->compare != NULL) {
+        while (current != NULL && list->compare(key, list_payload(current)) != 0) {
+            STATS_INC(list, traversal_steps);
+            prev = current;
+            current = current->next;
+        }
+    } else if (list->key_size == sizeof(uint32_t)) {
+        uint32_t wanted;
+        memcpy(&wanted, key, sizeof(wanted));
+        for (; current != NULL; prev = current, current = current->next) {
+            uint32_t bits;
+            memcpy(&bits, nodeKey(list, current), sizeof(bits));
+            if (bits == wanted) {
+                break;
+            }
+            STATS_INC(list, traversal_steps);
+        }
+    } else if (list->key_size == sizeof(uint64_t)) {
+        uint64_t wanted;
+        memcpy(&wanted, key, sizeof(wanted));
+        for (; current != NULL; prev = current, current = current->next) {
+            uint64_t bits;
+            memcpy(&bits, nodeKey(list, current), sizeof(bits));
+            if (bits == wanted) {
+                break;
+            }
+            STATS_INC(list, traversal_steps);
+        }
+    } else {
+        while (current != NULL && memcmp(nodeKey(list, current), key, list->key_size) != 0) {
+            STATS_INC(list, traversal_steps);
+            prev = current;
+            current = current->next;
+        }
+    }
+    if (prev_out != NULL) {
+        *prev_out = prev;
+    }
+    return current;
+}
+
+// Finds the first node matching 'key' and its predecessor (NULL for the head).
+// Kept small so the indexed lookup inlines into its callers.
+static inline Node* findNode(LinkedList *list, const void *key, Node **prev_out) {
+    STATS_INC(list, searches);
+    if (list->index == NULL) {
+        return scanForKey(list, key, prev_out);
+    }
+    // The index knows the first occurrence and its predecessor
+    ListIndexEntry *entry = list_index_find(list->index, indexKey(list, key));
+    if (prev_out != NULL) {
+        *prev_out = entry != NULL ? entry->prev : NULL;
+    }
+    return entry != NULL ? entry->node : NULL;
+}
+
+// --- Hash index upkeep; every helper is a no-op while list->index is NULL ---
+
+// Makes room for one more distinct value before a node is linked, so an
+// insert either fails with the list untouched or updates list and index together.
+static int indexReserveOne(LinkedList *list) {
+    if (list->index == NULL) {
+        return LIB_OK;
+    }
+    return list_index_reserve(list->index, list->index->used + 1);
+}
+
+// Records that 'node' now follows 'prev'. Only first occurrences track a predecessor.
+static void indexRelink(LinkedList *list, Node *prev, Node *node) {
+    if (list->index == NULL || node == NULL) {
+        return;
+    }
+    ListIndexEntry *entry = list_index_find(list->index, nodeIndexKey(list, node));
+    if (entry != NULL && entry->node == node) {
+        entry->prev = prev;
+    }
+}
+
+// Where a new node sits relative to existing nodes holding the same value
+typedef enum IndexPlacement {
+    INDEX_BEFORE_ALL, // inserted at the head
+    INDEX_AFTER_ALL,  // appended at the tail
+    INDEX_UNKNOWN     // inserted mid-list
+} IndexPlacement;
+
+// Counts 'node' (predecessor 'prev') into 'index' while it is built in list
+// order, so the first node seen per key becomes its entry. Capacity must be reserved.
+static void indexRecord(const LinkedList *list, ListIndex *index, Node *node, Node *prev) {
+    uint64_t key = nodeIndexKey(list, node);
+    ListIndexEntry *entry = list_index_find(index, key);
+    if (entry != NULL) {
+        entry->count++;
+    } else {
+        list_index_insert(index, key, node, prev);
+    }
+}
+
+// Recomputes every entry after nodes were reordered or moved in or out.
+// Capacity for the list's distinct keys must be reserved.
+static void indexRebuild(LinkedList *list) {
+    if (list->index == NULL) {
+        return;
+    }
+    list_index_clear(list->index);
+    Node *prev = NULL;
+    for (Node *current = list->head; current != NULL; prev = current, current = current->next) {
+        indexRecord(list, list->index, current, prev);
+    }
+}
+
+// Makes room for up to 'extra' more distinct values before nodes are moved in
+static int indexReserveMore(LinkedList *list, size_t extra) {
+    if (list->index == NULL) {
+        return LIB_OK;
+    }
+    return list_index_reserve(list->index, list->index->used + extra);
+}
+
+// Registers a freshly linked 'node' whose predecessor is 'prev'.
+static void indexAddNode(LinkedList *list, Node *node, Node *prev, IndexPlacement placement) {
+    if (list->index == NULL) {
+        return;
+    }
+    uint64_t key = nodeIndexKey(list, node);
+    ListIndexEntry *entry = list_index_find(list->index, key);
+    if (entry == NULL) {
+        list_index_insert(list->index, key, node, prev);
+        return;
+    }
+    entry->count++;
+    if (placement == INDEX_AFTER_ALL) {
+        return;
+    }
+    if (placement == INDEX_UNKNOWN) {
+        // Walk on from both occurrences in lock step: whichever reaches the
+        // other one first lies in front, and running off the end settles it
+        // too. Costs about twice the distance between the two nodes.
+        Node *from_new = node->next;
+        Node *from_old = entry->node->next;
+        for (;;) {
+            if (from_new == entry->node || from_old == NULL) {
+                break; // The new node comes first
+            }
+            if (from_old == node || from_new == NULL) {
+                return; // The existing first occurrence stays first
+            }
+            from_new = from_new->next;
+            from_old = from_old->next;
+        }
+    }
+    entry->node = node;
+    entry->prev = prev;
+}
+
+// Unregisters 'node', which was just unlinked from after 'prev' (node->next is still intact).
+static void indexRemoveNode(LinkedList *list, Node *node, Node *prev) {
+    if (list->index == NULL) {
+        return;
+    }
+    indexRelink(list, prev, node->next);
+    uint64_t key = nodeIndexKey(list, node);
+    ListIndexEntry *entry = list_index_find(list->index, key);
+    if (entry->node != node) {
+        entry->count--; // A later duplicate; the first occurrence is unchanged
+        return;
+    }
+    if (entry->count == 1) {
+        list_index_erase(list->index, entry);
+        return;
+    }
+    entry->count--;
+    // The next occurrence is somewhere after the removed node
+    Node *before = prev;
+    Node *current = node->next;
+    while (nodeIndexKey(list, current) != key) {
+        STATS_INC(list, traversal_steps);
+        before = current;
+        current = current->next;
+    }
+    entry->node = current;
+    entry->prev = before;
+}
+
+// Helper function to unlink 'node' (predecessor 'prev', NULL for the head) and free it
+static void removeNode(LinkedList *list, Node *prev, Node *node) {
+    if (prev == NULL) {
+        list->head = node->next;
+    } else {
+        prev->next = node->next;
+    }
+    if (node == list->tail) {
+        list->tail = prev;
+    }
+    indexRemoveNode(list, node, prev);
+    freeNode(list, node);
+    list->size--;
+}
+
+// Hash sets (the index, and the temporary sets of the bulk removals) need key bytes that fit a uint64_t
+static int hasHashableKeys(const LinkedList *list) {
+    return list->compare == NULL && list->key_size <= sizeof(uint64_t);
+}
+
+// The int functions apply only to lists whose payload is one int
+static int rejectNonIntList(const LinkedList *list) {
+    if (list != NULL && list->payload_size != sizeof(int)) {
+        DIAG_ERROR_MSG("List does not hold int payloads; use the list_* functions.");
+        return 1;
+    }
+    return 0;
+}
+
 LinkedList* createList() {
-    LinkedList *list = (LinkedList *)malloc(sizeof(LinkedList));
+    return createListWithAllocator(allocator_default());
+}
+
+LinkedList* createListWithAllocator(const Allocator *allocator) {
+    if (allocator == NULL) {
+        DIAG_ERROR_MSG("Allocator is NULL.");
+        return NULL;
+    }
+    ListConfig config = { sizeof(int), NULL, 0, sizeof(int), allocator, 0 };
+    return createListWithConfig(&config);
+}
+
+LinkedList* createListWithPool(MemPool *pool) {
+    if (pool == NULL || pool->block_size < sizeof(Node)) {
+        DIAG_ERROR_MSG("Pool is NULL or its blocks are too small for a Node.");
+        return NULL;
+    }
+    LinkedList *list = createList();
+    if (list != NULL) {
+        list->pool = pool;
+    }
+    return list;
+}
+
+LinkedList* createPooledList(size_t nodes_per_slab) {
+    ListConfig config = { sizeof(int), NULL, 0, sizeof(int), NULL, nodes_per_slab > 0 ? nodes_per_slab : 1 };
+    return createListWithConfig(&config);
+}
+
+LinkedList* createListWithConfig(const ListConfig *config) {
+    if (config == NULL || config->payload_size == 0) {
+        DIAG_ERROR_MSG("Config is NULL or its payload size is 0.");
+        return NULL;
+    }
+    size_t key_size = config->key_size;
+    if (config->compare == NULL) {
+        if (config->key_offset >= config->payload_size ||
+            key_size > config->payload_size - config->key_offset) {
+            DIAG_ERROR_MSG("Key at offset %zu does not fit in a %zu-byte payload.",
+                           config->key_offset, config->payload_size);
+            return NULL;
+        }
+        if (key_size == 0) {
+            key_size = config->payload_size - config->key_offset; // Rest of the payload
+        }
+    }
+    // Round up so nodes carved back to back from a slab keep 'next' aligned
+    if (config->payload_size > SIZE_MAX - sizeof(Node) - offsetof(ListNode, payload)) {
+        DIAG_ERROR_MSG("Payload of %zu bytes is too large.", config->payload_size);
+        return NULL;
+    }
+    size_t node_size = offsetof(ListNode, payload) + config->payload_size;
+    node_size = (node_size + _Alignof(Node) - 1) / _Alignof(Node) * _Alignof(Node);
+    if (node_size < sizeof(Node)) {
+        node_size = sizeof(Node);
+    }
+    const Allocator *allocator = config->allocator != NULL ? config->allocator : allocator_default();
+
+    MemPool *pool = NULL;
+    if (config->nodes_per_slab > 0) {
+        MemPoolConfig pool_config = { config->nodes_per_slab, node_size, POOL_GROWTH_DOUBLE, 0, 0, allocator };
+        pool = createPoolWithConfig(&pool_config);
+        if (pool == NULL) {
+            return NULL;
+        }
+    }
+    LinkedList *list = (LinkedList *)allocator->alloc(allocator->ctx, sizeof(LinkedList));
     if (list == NULL) {
-        perror("Failed to allocate memory for LinkedList");
-        exit(EXIT_FAILURE);
+        DIAG_ERROR_MSG("Failed to allocate memory for LinkedList.");
+        destroyPool(pool);
+        return NULL;
     }
     list->head = NULL;
+    list->tail = NULL;
     list->size = 0;
+    list->pool = pool;
+    list->owns_pool = pool != NULL;
+    list->allocator = allocator;
+    list->index = NULL;
+    list->payload_size = config->payload_size;
+    list->node_size = node_size;
+    list->compare = config->compare;
+    list->key_offset = config->compare == NULL ? config->key_offset : 0;
+    list->key_size = config->compare == NULL ? key_size : 0;
+    STATS_RESET(list);
     return list;
 }
 
+int enableListIndex(LinkedList *list) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("List is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (!hasHashableKeys(list)) {
+        DIAG_ERROR_MSG("Only lists with key bytes of at most 8 can be indexed.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (list->index != NULL) {
+        return LIB_OK; // Already enabled
+    }
+    ListIndex *index = list_index_create(list->allocator, list->size);
+    if (index == NULL) {
+        return LIB_ERR_NO_MEMORY;
+    }
+    Node *prev = NULL;
+    for (Node *current = list->head; current != NULL; prev = current, current = current->next) {
+        indexRecord(list, index, current, prev);
+    }
+    list->index = index;
+    return LIB_OK;
+}
+
+void disableListIndex(LinkedList *list) {
+    if (list == NULL) {
+        return;
+    }
+    list_index_destroy(list->index);
+    list->index = NULL;
+}
+
 int isEmpty(LinkedList *list) {
     if (list == NULL) {
-        fprintf(stderr, "Error: List is NULL in isEmpty.\n");
+        DIAG_ERROR_MSG("List is NULL.");
         return 1; // Treat as empty or error
     }
     return list->head == NULL; // Or list->size == 0;
 }
 
-void insertAtBeginning(LinkedList *list, int data) {
-    if (list == NULL) {
-        fprintf(stderr, "Error: List is NULL in insertAtBeginning.\n");
-        return;
+// --- Generic payload API ---
+
+int list_push_front(LinkedList *list, const void *payload) {
+    if (list == NULL || payload == NULL) {
+        DIAG_ERROR_MSG("List or payload is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    int status = indexReserveOne(list);
+    if (status != LIB_OK) {
+        return status;
+    }
+    Node *newNode = createNode(list, payload);
+    if (newNode == NULL) {
+        return LIB_ERR_NO_MEMORY;
     }
-    Node *newNode = createNode(data);
     newNode->next = list->head; // New node points to old head
     list->head = newNode;       // List head now points to new node
+    if (list->tail == NULL) {   // First node is also the last one
+        list->tail = newNode;
+    }
+    indexRelink(list, newNode, newNode->next);
+    indexAddNode(list, newNode, NULL, INDEX_BEFORE_ALL);
     list->size++;
-    printf("Inserted %d at beginning. Size: %zu\n", data, list->size);
+    STATS_MAX(list, peak_size, list->size);
+    DIAG_TRACE_MSG("Inserted at beginning. Size: %zu", list->size);
+    return LIB_OK;
 }
 
-void insertAtEnd(LinkedList *list, int data) {
-    if (list == NULL) {
-        fprintf(stderr, "Error: List is NULL in insertAtEnd.\n");
-        return;
+// Appends a node; shared by list_push_back() and insertAtEnd() so both inline it
+static inline int pushBack(LinkedList *list, const void *payload) {
+    int status = indexReserveOne(list);
+    if (status != LIB_OK) {
+        return status;
+    }
+    Node *newNode = createNode(list, payload);
+    if (newNode == NULL) {
+        return LIB_ERR_NO_MEMORY;
     }
-    Node *newNode = createNode(data);
 
+    Node *prev = list->tail;
     if (list->head == NULL) { // If list is empty, new node is the head
         list->head = newNode;
     } else {
-        Node *current = list->head;
-        while (current->next != NULL) { // Traverse to the last node
-            current = current->next;
-        }
-        current->next = newNode; // Last node points to the new node
+        list->tail->next = newNode; // Last node points to the new node
     }
+    list->tail = newNode;
+    indexAddNode(list, newNode, prev, INDEX_AFTER_ALL);
     list->size++;
-    printf("Inserted %d at end. Size: %zu\n", data, list->size);
+    STATS_MAX(list, peak_size, list->size);
+    DIAG_TRACE_MSG("Inserted at end. Size: %zu", list->size);
+    return LIB_OK;
 }
 
-int insertAfter(LinkedList *list, int data, int after_value) {
-    if (list == NULL) {
-        fprintf(stderr, "Error: List is NULL in insertAfter.\n");
+int list_push_back(LinkedList *list, const void *payload) {
+    if (list == NULL || payload == NULL) {
+        DIAG_ERROR_MSG("List or payload is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    return pushBack(list, payload);
+}
+
+int list_insert_after(LinkedList *list, const void *payload, const void *after_key) {
+    if (list == NULL || payload == NULL || after_key == NULL) {
+        DIAG_ERROR_MSG("List, payload or key is NULL.");
         return 0;
     }
-    Node *current = list->head;
-    while (current != NULL && current->data != after_value) {
-        current = current->next;
+    Node *current = findNode(list, after_key, NULL);
+    if (current == NULL) { // Key not found
+        DIAG_TRACE_MSG("Key not found. Cannot insert after it.");
+        return 0;
     }
 
-    if (current == NULL) { // Value not found
-        printf("Value %d not found. Cannot insert %d after it.\n", after_value, data);
+    // Key found, insert newNode after current
+    if (indexReserveOne(list) != LIB_OK) {
+        return 0;
+    }
+    Node *newNode = createNode(list, payload);
+    if (newNode == NULL) {
         return 0;
     }
-
-    // Value found, insert newNode after current
-    Node *newNode = createNode(data);
     newNode->next = current->next;
     current->next = newNode;
+    if (current == list->tail) { // Inserted after the last node
+        list->tail = newNode;
+    }
+    indexRelink(list, newNode, newNode->next);
+    indexAddNode(list, newNode, current, INDEX_UNKNOWN);
     list->size++;
-    printf("Inserted %d after %d. Size: %zu\n", data, after_value, list->size);
+    STATS_MAX(list, peak_size, list->size);
+    DIAG_TRACE_MSG("Inserted after key. Size: %zu", list->size);
     return 1;
 }
 
+void* list_find(LinkedList *list, const void *key) {
+    if (list == NULL || key == NULL) {
+        DIAG_ERROR_MSG("List or key is NULL.");
+        return NULL;
+    }
+    Node *node = findNode(list, key, NULL);
+    return node != NULL ? list_payload(node) : NULL;
+}
 
-int deleteNode(LinkedList *list, int data) {
-    if (list == NULL || list->head == NULL) {
-        printf("List is empty or NULL. Cannot delete %d.\n", data);
+int list_remove(LinkedList *list, const void *key) {
+    if (list == NULL || list->head == NULL || key == NULL) {
+        DIAG_TRACE_MSG("List is empty or NULL, or key is NULL. No deletion.");
         return 0; // List is empty
     }
+    Node *prev = NULL;
+    Node *current = findNode(list, key, &prev);
+    if (current == NULL) { // Key not found
+        DIAG_TRACE_MSG("Key not found in list. No deletion.");
+        return 0;
+    }
 
-    Node *current = list->head;
+    // Key found, bypass the current node
+    removeNode(list, prev, current);
+    DIAG_TRACE_MSG("Deleted from list. Size: %zu", list->size);
+    return 1;
+}
+
+int list_remove_at(LinkedList *list, size_t position, void *out) {
+    if (list == NULL || list->head == NULL) {
+        DIAG_ERROR_MSG("List is empty or NULL. Cannot delete from position %zu.", position);
+        return list == NULL ? LIB_ERR_INVALID_ARG : LIB_ERR_OUT_OF_RANGE;
+    }
+    if (position >= list->size) {
+        DIAG_ERROR_MSG("Invalid position %zu for deletion (list size: %zu).", position, list->size);
+        return LIB_ERR_OUT_OF_RANGE;
+    }
+
+    STATS_INC(list, searches);
+    // Find previous node of the node to be deleted
     Node *prev = NULL;
+    Node *node = list->head;
+    for (size_t i = 0; i < position; i++) {
+        STATS_INC(list, traversal_steps);
+        prev = node;
+        node = node->next;
+    }
+    if (out != NULL) {
+        copyPayload(out, list_payload(node), list->payload_size);
+    }
+    removeNode(list, prev, node); // Unlink and free the node
+    DIAG_TRACE_MSG("Deleted at position %zu. Size: %zu", position, list->size);
+    return LIB_OK;
+}
 
-    // Case 1: Node to be deleted is the head
-    if (current != NULL && current->data == data) {
-        list->head = current->next; // Move head to next node
-        free(current);             // Free the old head
-        current = NULL;
-        list->size--;
-        printf("Deleted %d from list. Size: %zu\n", data, list->size);
-        return 1;
+// --- Bulk operations: one pass over the list, removed nodes freed together ---
+
+// Decides whether sweepList() removes 'node'
+typedef int (*DropFn)(LinkedList *list, Node *node, void *ctx);
+
+// Unlinks every node 'drop' selects, in one pass, and then frees them as one
+// chain. An enabled index is cleared up front and rebuilt from the kept nodes
+// as the pass reaches them, which is cheaper than fixing it per removal.
+static inline size_t sweepList(LinkedList *list, DropFn drop, void *ctx) {
+    if (list->index != NULL) {
+        list_index_clear(list->index);
+    }
+    Node **link = &list->head; // Where the next kept node gets linked
+    Node *kept = NULL;         // Last node kept so far
+    Node *dropped_head = NULL;
+    Node *dropped_tail = NULL;
+    size_t dropped = 0;
+    Node *current = list->head;
+    while (current != NULL) {
+        Node *next = current->next;
+        if (drop(list, current, ctx)) {
+            if (dropped_tail == NULL) {
+                dropped_head = current;
+            } else {
+                dropped_tail->next = current;
+            }
+            dropped_tail = current;
+            dropped++;
+        } else {
+            if (*link != current) { // Only write links that change
+                *link = current;
+            }
+            link = &current->next;
+            if (list->index != NULL) {
+                indexRecord(list, list->index, current, kept);
+            }
+            kept = current;
+        }
+        current = next;
     }
+    *link = NULL;
+    list->tail = kept;
+    list->size -= dropped;
+    if (dropped_tail != NULL) {
+        dropped_tail->next = NULL;
+    }
+    freeChain(list, dropped_head, dropped_tail, dropped);
+    return dropped;
+}
 
-    // Case 2: Node to be deleted is elsewhere in the list
-    while (current != NULL && current->data != data) {
-        prev = current;
-        current = current->next;
+LinkedList* list_from_array(const ListConfig *config, const void *payloads, size_t count) {
+    ListConfig settings = { sizeof(int), NULL, 0, sizeof(int), NULL, 0 };
+    if (config != NULL) {
+        settings = *config;
+    }
+    if (payloads == NULL && count > 0) {
+        DIAG_ERROR_MSG("Payload array is NULL.");
+        return NULL;
+    }
+    if (settings.nodes_per_slab > 0 && settings.nodes_per_slab < count) {
+        settings.nodes_per_slab = count; // One slab for the whole array
+    }
+    LinkedList *list = createListWithConfig(&settings);
+    if (list == NULL) {
+        return NULL;
+    }
+    const unsigned char *payload = (const unsigned char *)payloads;
+    Node **link = &list->head;
+    for (size_t i = 0; i < count; ++i, payload += list->payload_size) {
+        Node *newNode = createNode(list, payload);
+        if (newNode == NULL) {
+            destroyList(list); // Frees the nodes linked so far
+            return NULL;
+        }
+        *link = newNode;
+        link = &newNode->next;
+        list->tail = newNode;
+        list->size++;
     }
+    STATS_MAX(list, peak_size, list->size);
+    DIAG_TRACE_MSG("List built from %zu payloads.", count);
+    return list;
+}
+
+typedef struct PredicateCall {
+    ListPredicateFn pred;
+    void *ctx;
+} PredicateCall;
+
+static int dropMatching(LinkedList *list, Node *node, void *ctx) {
+    (void)list;
+    const PredicateCall *call = (const PredicateCall *)ctx;
+    return call->pred(list_payload(node), call->ctx) != 0;
+}
 
-    if (current == NULL) { // Data not found
-        printf("%d not found in list. No deletion.\n", data);
+size_t list_remove_if(LinkedList *list, ListPredicateFn pred, void *ctx) {
+    if (list == NULL || pred == NULL) {
+        DIAG_ERROR_MSG("List or predicate is NULL.");
         return 0;
     }
+    PredicateCall call = { pred, ctx };
+    size_t removed = sweepList(list, dropMatching, &call);
+    DIAG_TRACE_MSG("Removed %zu nodes. Size: %zu", removed, list->size);
+    return removed;
+}
 
-    // Data found, bypass the current node
-    prev->next = current->next;
-    free(current); // Free the node
-    current = NULL;
-    list->size--;
-    printf("Deleted %d from list. Size: %zu\n", data, list->size);
-    return 1;
+// Stands in for a node in a temporary value set, whose slots must not hold NULL
+static Node setMember;
+
+static int dropListed(LinkedList *list, Node *node, void *ctx) {
+    return list_index_find((const ListIndex *)ctx, nodeIndexKey(list, node)) != NULL;
 }
 
-int deleteAtPosition(LinkedList *list, int position) {
-    if (list == NULL || list->head == NULL) {
-        fprintf(stderr, "Error: List is empty or NULL. Cannot delete from position %d.\n", position);
-        return -1; // Indicate error
+int list_remove_all_of(LinkedList *list, const void *values, size_t count, size_t *removed) {
+    if (removed != NULL) {
+        *removed = 0;
+    }
+    if (list == NULL || (values == NULL && count > 0)) {
+        DIAG_ERROR_MSG("List or value array is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (!hasHashableKeys(list)) {
+        DIAG_ERROR_MSG("Only lists with key bytes of at most 8 support removing a set of values.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (count == 0 || list->head == NULL) {
+        return LIB_OK;
+    }
+    ListIndex *set = list_index_create(list->allocator, count);
+    if (set == NULL) {
+        return LIB_ERR_NO_MEMORY;
     }
+    const unsigned char *value = (const unsigned char *)values;
+    for (size_t i = 0; i < count; ++i, value += list->key_size) {
+        uint64_t key = indexKey(list, value);
+        if (list_index_find(set, key) == NULL) {
+            list_index_insert(set, key, &setMember, NULL);
+        }
+    }
+    size_t dropped = sweepList(list, dropListed, set);
+    list_index_destroy(set);
+    if (removed != NULL) {
+        *removed = dropped;
+    }
+    DIAG_TRACE_MSG("Removed %zu nodes. Size: %zu", dropped, list->size);
+    return LIB_OK;
+}
 
-    if (position < 0 || (size_t)position >= list->size) {
-        fprintf(stderr, "Error: Invalid position %d for deletion (list size: %zu).\n", position, list->size);
-        return -1; // Indicate error
+static int dropSeen(LinkedList *list, Node *node, void *ctx) {
+    ListIndex *seen = (ListIndex *)ctx;
+    uint64_t key = nodeIndexKey(list, node);
+    if (list_index_find(seen, key) != NULL) {
+        return 1;
+    }
+    if (seen != list->index) { // sweepList() records kept nodes in the list's own index
+        list_index_insert(seen, key, node, NULL);
     }
+    return 0;
+}
 
-    Node *temp = list->head;
-    int deleted_data;
+int list_unique(LinkedList *list, size_t *removed) {
+    if (removed != NULL) {
+        *removed = 0;
+    }
+    if (list == NULL) {
+        DIAG_ERROR_MSG("List is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (!hasHashableKeys(list)) {
+        DIAG_ERROR_MSG("Only lists with key bytes of at most 8 support list_unique.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (list->size < 2) {
+        return LIB_OK;
+    }
+    ListIndex *seen = list->index;
+    if (seen == NULL) {
+        seen = list_index_create(list->allocator, list->size);
+        if (seen == NULL) {
+            return LIB_ERR_NO_MEMORY;
+        }
+    }
+    size_t dropped = sweepList(list, dropSeen, seen);
+    if (seen != list->index) {
+        list_index_destroy(seen);
+    }
+    if (removed != NULL) {
+        *removed = dropped;
+    }
+    DIAG_TRACE_MSG("Removed %zu duplicates. Size: %zu", dropped, list->size);
+    return LIB_OK;
+}
+
+// --- Sorting and moving nodes between lists: links are rewritten, nodes never allocated ---
+
+// A NULL-terminated chain of nodes and its last node
+typedef struct NodeRun {
+    Node *head;
+    Node *tail;
+} NodeRun;
 
-    // If head needs to be removed
-    if (position == 0) {
-        list->head = temp->next;
-        deleted_data = temp->data;
-        free(temp);
-        temp = NULL;
-        list->size--;
-        printf("Deleted %d at position %d. Size: %zu\n", deleted_data, position, list->size);
-        return deleted_data;
+// Whether 'a' may stay in front of 'b'; int payloads are compared inline without 'order'
+static inline int inOrder(Node *a, Node *b, ListOrderFn order) {
+    if (order == NULL) {
+        return a->data <= b->data;
     }
+    return order(list_payload(a), list_payload(b)) <= 0;
+}
 
-    // Find previous node of the node to be deleted
-    for (int i = 0; temp != NULL && i < position - 1; i++) {
-        temp = temp->next;
+// Merges two sorted runs. On ties the nodes of 'a' go first, which keeps the sort stable.
+static inline NodeRun mergeRuns(NodeRun a, NodeRun b, ListOrderFn order) {
+    if (a.head == NULL) {
+        return b;
+    }
+    if (b.head == NULL) {
+        return a;
     }
+    if (inOrder(a.tail, b.head, order)) { // Already in order: just chain them
+        a.tail->next = b.head;
+        NodeRun joined = { a.head, b.tail };
+        return joined;
+    }
+    Node *head;
+    Node **link = &head;
+    Node *x = a.head;
+    Node *y = b.head;
+    for (;;) {
+        if (inOrder(x, y, order)) {
+            *link = x;
+            link = &x->next;
+            x = x->next;
+            if (x == NULL) {
+                *link = y;
+                NodeRun merged = { head, b.tail };
+                return merged;
+            }
+        } else {
+            *link = y;
+            link = &y->next;
+            y = y->next;
+            if (y == NULL) {
+                *link = x;
+                NodeRun merged = { head, a.tail };
+                return merged;
+            }
+        }
+    }
+}
 
-    // If position is more than number of nodes
-    if (temp == NULL || temp->next == NULL) {
-        fprintf(stderr, "Error: Position %d out of bounds during traversal.\n", position);
-        return -1; // Should not happen if previous checks are correct
+// Bottom-up merge sort over natural runs. bins[i] holds the merge of 2^i
+// runs, so merging works like incrementing a binary counter and every node
+// takes part in at most log2(runs) + 1 merges. The bins live on the stack.
+static inline NodeRun sortChain(Node *head, ListOrderFn order) {
+    NodeRun bins[sizeof(size_t) * 8];
+    size_t used = 0; // bins[0..used) are initialized, empty ones have a NULL head
+    while (head != NULL) {
+        // Cut off the next non-descending run
+        NodeRun run = { head, head };
+        while (run.tail->next != NULL && inOrder(run.tail, run.tail->next, order)) {
+            run.tail = run.tail->next;
+        }
+        head = run.tail->next;
+        run.tail->next = NULL;
+
+        size_t i = 0;
+        for (; i < used && bins[i].head != NULL; ++i) {
+            run = mergeRuns(bins[i], run, order); // The bin holds earlier nodes
+            bins[i].head = NULL;
+        }
+        if (i == used) {
+            used++;
+        }
+        bins[i] = run;
+    }
+    NodeRun sorted = { NULL, NULL };
+    for (size_t i = 0; i < used; ++i) {
+        sorted = mergeRuns(bins[i], sorted, order); // Higher bins hold earlier nodes
     }
+    return sorted;
+}
 
-    Node *node_to_delete = temp->next; // Node at the given position
-    deleted_data = node_to_delete->data;
-    temp->next = node_to_delete->next; // Unlink the node
-    free(node_to_delete);             // Free memory
-    node_to_delete=NULL;
-    list->size--;
-    printf("Deleted %d at position %d. Size: %zu\n", deleted_data, position, list->size);
-    return deleted_data;
+// An int order needs int payloads
+static int rejectMissingOrder(const LinkedList *list, ListOrderFn order) {
+    if (order == NULL && list->payload_size != sizeof(int)) {
+        DIAG_ERROR_MSG("Lists without int payloads need an order function.");
+        return 1;
+    }
+    return 0;
+}
+
+// Nodes may only move to a list that frees them the same way
+static int rejectIncompatibleLists(const LinkedList *dest, const LinkedList *src) {
+    if (dest == NULL || src == NULL || dest == src) {
+        DIAG_ERROR_MSG("List is NULL, or both lists are the same.");
+        return 1;
+    }
+    if (dest->payload_size != src->payload_size || dest->pool != src->pool ||
+        (dest->pool == NULL && dest->allocator != src->allocator)) {
+        DIAG_ERROR_MSG("Lists do not store nodes the same way; nodes cannot move between them.");
+        return 1;
+    }
+    return 0;
+}
+
+// Leaves 'list' empty after its nodes were handed to another list
+static void forgetNodes(LinkedList *list) {
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    if (list->index != NULL) {
+        list_index_clear(list->index);
+    }
 }
 
+int list_sort(LinkedList *list, ListOrderFn order) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("List is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (rejectMissingOrder(list, order)) {
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (list->head == NULL) {
+        return LIB_OK;
+    }
+    // Separate calls so the int comparison is inlined into its own copy
+    NodeRun sorted = order == NULL ? sortChain(list->head, NULL) : sortChain(list->head, order);
+    list->head = sorted.head;
+    list->tail = sorted.tail;
+    indexRebuild(list); // Same keys, new predecessors
+    DIAG_TRACE_MSG("Sorted list of %zu nodes.", list->size);
+    return LIB_OK;
+}
+
+int list_merge_sorted(LinkedList *dest, LinkedList *src, ListOrderFn order) {
+    if (rejectIncompatibleLists(dest, src) || rejectMissingOrder(dest, order)) {
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (src->head == NULL) {
+        return LIB_OK;
+    }
+    int status = indexReserveMore(dest, src->size);
+    if (status != LIB_OK) {
+        return status;
+    }
+    NodeRun a = { dest->head, dest->tail };
+    NodeRun b = { src->head, src->tail };
+    NodeRun merged = order == NULL ? mergeRuns(a, b, NULL) : mergeRuns(a, b, order);
+    dest->head = merged.head;
+    dest->tail = merged.tail;
+    dest->size += src->size;
+    STATS_MAX(dest, peak_size, dest->size);
+    forgetNodes(src);
+    indexRebuild(dest);
+    DIAG_TRACE_MSG("Merged lists. Size: %zu", dest->size);
+    return LIB_OK;
+}
+
+int list_splice(LinkedList *dest, Node *after, LinkedList *src) {
+    if (rejectIncompatibleLists(dest, src)) {
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (src->head == NULL) {
+        return LIB_OK;
+    }
+    int status = indexReserveMore(dest, src->size);
+    if (status != LIB_OK) {
+        return status;
+    }
+    Node *first = src->head;
+    Node *last = src->tail;
+    int at_tail = after == dest->tail; // Also true for an empty dest
+    if (after == NULL) {
+        last->next = dest->head;
+        dest->head = first;
+    } else {
+        last->next = after->next;
+        after->next = first;
+    }
+    if (last->next == NULL) {
+        dest->tail = last;
+    }
+    dest->size += src->size;
+    STATS_MAX(dest, peak_size, dest->size);
+    forgetNodes(src);
+    if (dest->index != NULL) {
+        if (at_tail) {
+            // Appended nodes come after every existing occurrence: count them in order
+            Node *prev = after;
+            for (Node *current = first; current != NULL; prev = current, current = current->next) {
+                indexRecord(dest, dest->index, current, prev);
+            }
+        } else {
+            indexRebuild(dest);
+        }
+    }
+    DIAG_TRACE_MSG("Spliced lists. Size: %zu", dest->size);
+    return LIB_OK;
+}
+
+int list_split_at(LinkedList *list, size_t position, LinkedList *rest) {
+    if (rejectIncompatibleLists(rest, list)) {
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (rest->head != NULL) {
+        DIAG_ERROR_MSG("The list receiving the split must be empty.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (position > list->size) {
+        DIAG_ERROR_MSG("Invalid split position %zu (list size: %zu).", position, list->size);
+        return LIB_ERR_OUT_OF_RANGE;
+    }
+    if (position == list->size) {
+        return LIB_OK;
+    }
+    int status = indexReserveMore(rest, list->size - position);
+    if (status != LIB_OK) {
+        return status;
+    }
+    STATS_INC(list, searches);
+    Node *prev = NULL;
+    Node *node = list->head;
+    for (size_t i = 0; i < position; ++i) {
+        STATS_INC(list, traversal_steps);
+        prev = node;
+        node = node->next;
+    }
+    rest->head = node;
+    rest->tail = list->tail;
+    rest->size = list->size - position;
+    STATS_MAX(rest, peak_size, rest->size);
+    if (prev == NULL) {
+        list->head = NULL;
+    } else {
+        prev->next = NULL;
+    }
+    list->tail = prev;
+    list->size = position;
+    indexRebuild(list);
+    indexRebuild(rest);
+    DIAG_TRACE_MSG("Split list at %zu.", position);
+    return LIB_OK;
+}
+
+// --- int API, a specialization of the functions above ---
+
+int insertAtBeginning(LinkedList *list, int data) {
+    if (rejectNonIntList(list)) {
+        return LIB_ERR_INVALID_ARG;
+    }
+    return list_push_front(list, &data);
+}
+
+int insertAtEnd(LinkedList *list, int data) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("List is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (rejectNonIntList(list)) {
+        return LIB_ERR_INVALID_ARG;
+    }
+    return pushBack(list, &data);
+}
+
+int insertAfter(LinkedList *list, int data, int after_value) {
+    if (rejectNonIntList(list)) {
+        return 0;
+    }
+    return list_insert_after(list, &data, &after_value);
+}
+
+int deleteNode(LinkedList *list, int data) {
+    if (rejectNonIntList(list)) {
+        return 0;
+    }
+    return list_remove(list, &data);
+}
+
+int deleteAtPosition(LinkedList *list, int position) {
+    if (rejectNonIntList(list)) {
+        return -1;
+    }
+    if (position < 0) {
+        DIAG_ERROR_MSG("Invalid position %d for deletion.", position);
+        return -1; // Indicate error
+    }
+    int deleted_data;
+    if (list_remove_at(list, (size_t)position, &deleted_data) != LIB_OK) {
+        return -1; // Indicate error
+    }
+    return deleted_data;
+}
 
 Node* searchList(LinkedList *list, int data) {
     if (list == NULL) {
-        fprintf(stderr, "Error: List is NULL in searchList.\n");
+        DIAG_ERROR_MSG("List is NULL.");
         return NULL;
     }
-    Node *current = list->head;
-    while (current != NULL) {
-        if (current->data == data) {
-            return current; // Found the data
-        }
-        current = current->next;
+    if (rejectNonIntList(list)) {
+        return NULL;
     }
-    return NULL; // Data not found
+    return findNode(list, &data, NULL);
 }
 
 void printList(LinkedList *list) {
@@ -201,6 +1096,10 @@ void printList(LinkedList *list) {
         printf("List is empty.\n");
         return;
     }
+    if (list->payload_size != sizeof(int)) {
+        printf("List of %zu payloads, %zu bytes each.\n", list->size, list->payload_size);
+        return;
+    }
     Node *current = list->head;
     printf("List elements (%zu): ", list->size);
     while (current != NULL) {
@@ -212,7 +1111,7 @@ void printList(LinkedList *list) {
 
 size_t getListSize(LinkedList *list) {
     if (list == NULL) {
-        fprintf(stderr, "Error: List is NULL in getListSize.\n");
+        DIAG_ERROR_MSG("List is NULL.");
         return 0;
     }
     return list->size;
@@ -222,15 +1121,22 @@ void destroyList(LinkedList *list) {
     if (list == NULL) {
         return; // Nothing to destroy
     }
-    Node *current = list->head;
-    Node *next_node;
-    while (current != NULL) {
-        next_node = current->next; // Store next node before freeing current
-        free(current);             // Free the current node
-        current =NULL;
-        current = next_node;       // Move to the next node
+    if (list->owns_pool) {
+        // Every node lives in the list's own slabs: release them wholesale
+        destroyPool(list->pool);
+        list->pool = NULL;
+    } else {
+        Node *current = list->head;
+        Node *next_node;
+        while (current != NULL) {
+            next_node = current->next; // Store next node before freeing current
+            freeNode(list, current);   // Free the current node
+            current =NULL;
+            current = next_node;       // Move to the next node
+        }
     }
-    free(list); // Free the LinkedList structure itself
+    list_index_destroy(list->index);
+    list->allocator->free(list->allocator->ctx, list, sizeof(LinkedList)); // Free the LinkedList structure itself
     list =NULL;
-    printf("List destroyed and memory deallocated.\n");
+    DIAG_TRACE_MSG("List destroyed and memory deallocated.");
 }
\ No newline at end of file
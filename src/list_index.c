@@ -0,0 +1,139 @@
+#include "list_index_internal.h"
+#include "diag_internal.h" // For DIAG_ERROR_MSG
+#include <stdint.h> // For uint64_t, SIZE_MAX
+#include <string.h> // For memset
+
+#define LIST_INDEX_MIN_CAPACITY 16
+
+// Fibonacci hashing spreads consecutive keys over the table; the xor-shift
+// folds the well-mixed high bits into the low bits used by the mask. Wide
+// keys are folded to 32 bits first, so int keys hash as they always did.
+static inline size_t home_slot(const ListIndex *index, uint64_t key) {
+    uint32_t h = ((uint32_t)key ^ (uint32_t)(key >> 32)) * 0x9E3779B1u;
+    h ^= h >> 15;
+    return (size_t)h & (index->capacity - 1);
+}
+
+// Keeps the table at most 3/4 full; linear probing stays short below that.
+static int fits(size_t capacity, size_t distinct) {
+    return distinct <= capacity - capacity / 4;
+}
+
+static ListIndexEntry* alloc_slots(const Allocator *allocator, size_t capacity) {
+    if (capacity > SIZE_MAX / sizeof(ListIndexEntry)) {
+        return NULL;
+    }
+    ListIndexEntry *slots = (ListIndexEntry *)allocator->alloc(allocator->ctx, capacity * sizeof(ListIndexEntry));
+    if (slots != NULL) {
+        memset(slots, 0, capacity * sizeof(ListIndexEntry)); // node == NULL marks a free slot
+    }
+    return slots;
+}
+
+static size_t capacity_for(size_t distinct) {
+    size_t capacity = LIST_INDEX_MIN_CAPACITY;
+    while (!fits(capacity, distinct) && capacity <= SIZE_MAX / 2) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+ListIndex* list_index_create(const Allocator *allocator, size_t expected) {
+    ListIndex *index = (ListIndex *)allocator->alloc(allocator->ctx, sizeof(ListIndex));
+    if (index == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate memory for ListIndex.");
+        return NULL;
+    }
+    index->capacity = capacity_for(expected);
+    index->used = 0;
+    index->allocator = allocator;
+    index->slots = alloc_slots(allocator, index->capacity);
+    if (index->slots == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate %zu index slots.", index->capacity);
+        allocator->free(allocator->ctx, index, sizeof(ListIndex));
+        return NULL;
+    }
+    return index;
+}
+
+void list_index_destroy(ListIndex *index) {
+    if (index == NULL) {
+        return;
+    }
+    const Allocator *allocator = index->allocator;
+    allocator->free(allocator->ctx, index->slots, index->capacity * sizeof(ListIndexEntry));
+    allocator->free(allocator->ctx, index, sizeof(ListIndex));
+}
+
+void list_index_clear(ListIndex *index) {
+    memset(index->slots, 0, index->capacity * sizeof(ListIndexEntry));
+    index->used = 0;
+}
+
+int list_index_reserve(ListIndex *index, size_t distinct) {
+    if (fits(index->capacity, distinct)) {
+        return LIB_OK;
+    }
+    size_t new_capacity = capacity_for(distinct);
+    ListIndexEntry *new_slots = alloc_slots(index->allocator, new_capacity);
+    if (new_slots == NULL) {
+        DIAG_ERROR_MSG("Failed to grow the list index to %zu slots.", new_capacity);
+        return LIB_ERR_NO_MEMORY;
+    }
+    ListIndexEntry *old_slots = index->slots;
+    size_t old_capacity = index->capacity;
+    index->slots = new_slots;
+    index->capacity = new_capacity;
+    for (size_t i = 0; i < old_capacity; ++i) {
+        if (old_slots[i].node != NULL) {
+            size_t slot = home_slot(index, old_slots[i].key);
+            while (new_slots[slot].node != NULL) {
+                slot = (slot + 1) & (new_capacity - 1);
+            }
+            new_slots[slot] = old_slots[i];
+        }
+    }
+    index->allocator->free(index->allocator->ctx, old_slots, old_capacity * sizeof(ListIndexEntry));
+    return LIB_OK;
+}
+
+ListIndexEntry* list_index_find(const ListIndex *index, uint64_t key) {
+    size_t mask = index->capacity - 1;
+    for (size_t slot = home_slot(index, key); index->slots[slot].node != NULL; slot = (slot + 1) & mask) {
+        if (index->slots[slot].key == key) {
+            return &index->slots[slot];
+        }
+    }
+    return NULL;
+}
+
+ListIndexEntry* list_index_insert(ListIndex *index, uint64_t key, Node *node, Node *prev) {
+    size_t mask = index->capacity - 1;
+    size_t slot = home_slot(index, key);
+    while (index->slots[slot].node != NULL) {
+        slot = (slot + 1) & mask;
+    }
+    ListIndexEntry *entry = &index->slots[slot];
+    entry->node = node;
+    entry->prev = prev;
+    entry->count = 1;
+    entry->key = key;
+    index->used++;
+    return entry;
+}
+
+void list_index_erase(ListIndex *index, ListIndexEntry *entry) {
+    size_t mask = index->capacity - 1;
+    size_t hole = (size_t)(entry - index->slots);
+    // Backward-shift deletion: pull each later slot of the probe run into the
+    // hole unless that would move it in front of its home slot.
+    for (size_t slot = (hole + 1) & mask; index->slots[slot].node != NULL; slot = (slot + 1) & mask) {
+        size_t home = home_slot(index, index->slots[slot].key);
+        if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+            index->slots[hole] = index->slots[slot];
+            hole = slot;
+        }
+    }
+    index->slots[hole].node = NULL;
+    index->used--;
+}
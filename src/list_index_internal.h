@@ -0,0 +1,52 @@
+#ifndef LIST_INDEX_INTERNAL_H
+#define LIST_INDEX_INTERNAL_H
+
+#include <stddef.h>
+#include <stdint.h> // For uint64_t
+#include "allocator.h"
+#include "linked_list.h" // For Node
+
+// Library-private hash index behind enableListIndex().
+//
+// A flat open-addressing table (linear probing, power-of-two capacity) with
+// one slot per distinct key. Keys are the list's key bytes (at most 8),
+// zero-extended into a uint64_t. Each slot remembers the first node holding the
+// value and that node's predecessor, so a singly linked node can be unlinked
+// without a scan. Deletion shifts later slots back instead of leaving
+// tombstones, so probe runs never degrade.
+typedef struct ListIndexEntry {
+    Node *node;   // First node holding 'key', or NULL for an empty slot
+    Node *prev;   // Predecessor of 'node', NULL when 'node' is the head
+    size_t count; // Number of nodes holding 'key'
+    uint64_t key;
+} ListIndexEntry;
+
+typedef struct ListIndex {
+    ListIndexEntry *slots;
+    size_t capacity; // Always a power of two
+    size_t used;     // Occupied slots, i.e. distinct values
+    const Allocator *allocator;
+} ListIndex;
+
+// Returns an empty index sized for about 'expected' distinct keys, or NULL.
+ListIndex* list_index_create(const Allocator *allocator, size_t expected);
+void list_index_destroy(ListIndex *index);
+
+// Empties the index but keeps its capacity, so re-adding up to the
+// previous number of distinct keys needs no reserve.
+void list_index_clear(ListIndex *index);
+
+// Grows the table so that 'distinct' keys fit under the load limit.
+// Called before a list mutation so the mutation itself cannot fail.
+int list_index_reserve(ListIndex *index, size_t distinct);
+
+// Returns the slot for 'key', or NULL if no node holds it.
+ListIndexEntry* list_index_find(const ListIndex *index, uint64_t key);
+
+// Adds a slot for a 'key' that is not present; capacity must be reserved.
+ListIndexEntry* list_index_insert(ListIndex *index, uint64_t key, Node *node, Node *prev);
+
+// Removes 'entry', which must have come from list_index_find on 'index'.
+void list_index_erase(ListIndex *index, ListIndexEntry *entry);
+
+#endif // LIST_INDEX_INTERNAL_H
@@ -55,6 +55,15 @@ int main() {
     printf("\n");
     printf("Integer vector size: %zu, capacity: %zu\n", vector_size(int_vec), int_vec->capacity);
 
+    // Appending an element of the vector itself is fine, even when the add has to grow
+    while (vector_size(int_vec) < int_vec->capacity) {
+        vector_add(int_vec, vector_get(int_vec, 0));
+    }
+    if (vector_add(int_vec, vector_get(int_vec, 0)) == 0) {
+        printf("Re-added the first element on a full vector: %d (capacity now %zu).\n",
+               *(int*)vector_get(int_vec, (int)vector_size(int_vec) - 1), int_vec->capacity);
+    }
+
 
     vector_destroy(int_vec);
     printf("\nInteger vector destroyed.\n");
@@ -1,5 +1,7 @@
 #include "mempool.h"
-#include <stdio.h>
+#include "diag_internal.h"
+#include "stats_internal.h"
+#include <stdint.h>
 #include <stdlib.h>
 
 /**
@@ -17,46 +19,130 @@ static size_t align_size(size_t size) {
     return (size + align - 1) & ~(align - 1);
 }
 
+/**
+ * @brief Returns the address of the first block in a slab.
+ */
+static char* slab_blocks(MemPoolSlab *slab) {
+    return (char*)slab + align_size(sizeof(MemPoolSlab));
+}
+
+/**
+ * @brief Returns the bytes of a slab holding 'num_blocks' blocks.
+ */
+static size_t slab_bytes(const MemPool *pool, size_t num_blocks) {
+    return align_size(sizeof(MemPoolSlab)) + num_blocks * pool->block_size;
+}
+
+/**
+ * @brief Pushes a block onto the free list without touching the counters.
+ */
+static void push_free_block(MemPool *pool, void *ptr) {
+    FreeNode *node = (FreeNode*)ptr;
+    node->next = pool->free_list_head;
+    pool->free_list_head = node;
+}
+
+/**
+ * @brief Picks the size of the next slab according to the growth policy.
+ *
+ * @return The number of blocks to add, or 0 if the pool may not grow.
+ */
+static size_t next_slab_blocks(const MemPool *pool) {
+    size_t blocks;
+    switch (pool->growth) {
+        case POOL_GROWTH_FIXED:
+            blocks = pool->growth_blocks;
+            break;
+        case POOL_GROWTH_DOUBLE:
+            blocks = pool->num_blocks > 0 ? pool->num_blocks : 1;
+            break;
+        default:
+            return 0;
+    }
+    if (pool->max_blocks > 0) {
+        size_t room = pool->max_blocks > pool->num_blocks ? pool->max_blocks - pool->num_blocks : 0;
+        if (blocks > room) {
+            blocks = room;
+        }
+    }
+    return blocks;
+}
+
 MemPool* createPool(size_t num_blocks, size_t block_size) {
+    MemPoolConfig config = { num_blocks, block_size, POOL_GROWTH_NONE, 0, 0, NULL };
+    return createPoolWithConfig(&config);
+}
+
+MemPool* createPoolWithConfig(const MemPoolConfig *config) {
+    if (config == NULL || config->initial_blocks == 0 || config->block_size == 0) {
+        DIAG_ERROR_MSG("Initial block count and block size must be greater than 0.");
+        return NULL;
+    }
+    if (config->growth == POOL_GROWTH_FIXED && config->growth_blocks == 0) {
+        DIAG_ERROR_MSG("POOL_GROWTH_FIXED needs a non-zero growth_blocks.");
+        return NULL;
+    }
+
     // We need to ensure that each block is at least the size of a FreeNode
     // so we can store a pointer in it when it's free.
-    size_t effective_block_size = block_size > sizeof(FreeNode) ? block_size : sizeof(FreeNode);
+    size_t effective_block_size = config->block_size > sizeof(FreeNode) ? config->block_size : sizeof(FreeNode);
     effective_block_size = align_size(effective_block_size);
 
-    MemPool *pool = (MemPool *)malloc(sizeof(MemPool));
+    const Allocator *allocator = config->allocator != NULL ? config->allocator : allocator_default();
+    MemPool *pool = (MemPool *)allocator->alloc(allocator->ctx, sizeof(MemPool));
     if (pool == NULL) {
-        perror("Failed to allocate memory for MemPool structure");
+        DIAG_ERROR_MSG("Failed to allocate memory for MemPool structure.");
         return NULL;
     }
-
-    // Allocate a single contiguous buffer for all blocks
-    pool->total_size = num_blocks * effective_block_size;
+    pool->total_size = 0;
     pool->block_size = effective_block_size;
-    pool->buffer = malloc(pool->total_size);
-    if (pool->buffer == NULL) {
-        perror("Failed to allocate memory for memory pool buffer");
-        free(pool);
+    pool->num_blocks = 0;
+    pool->free_list_head = NULL;
+    pool->bump_next = NULL;
+    pool->bump_end = NULL;
+    pool->slabs = NULL;
+    pool->growth = config->growth;
+    pool->growth_blocks = config->growth_blocks;
+    pool->max_blocks = config->max_blocks;
+    pool->allocator = allocator;
+    STATS_RESET(pool);
+
+    // The initial slab is allocated like any other one
+    if (growPool(pool, config->initial_blocks) != LIB_OK) {
+        DIAG_ERROR_MSG("Failed to allocate memory for memory pool buffer.");
+        allocator->free(allocator->ctx, pool, sizeof(MemPool));
         pool = NULL;
         return NULL;
     }
 
-    // Initialize the free list
-    pool->free_list_head = NULL;
-    for (size_t i = 0; i < num_blocks; ++i) {
-        void *current_block = (char*)pool->buffer + (i * pool->block_size);
-        deallocate(pool, current_block);
-    }
-
-    printf("Memory pool created with %zu blocks of size %zu (total size: %zu bytes)\n",
-           num_blocks, effective_block_size, pool->total_size);
+    DIAG_TRACE_MSG("Memory pool created with %zu blocks of size %zu (total size: %zu bytes)",
+           config->initial_blocks, effective_block_size, pool->total_size);
 
     return pool;
 }
 
 void* allocate(MemPool *pool) {
-    if (pool == NULL || pool->free_list_head == NULL) {
-        printf("Error: Pool is NULL or exhausted.\n");
-        return NULL; // Pool is either not created or all blocks are in use
+    if (pool == NULL) {
+        return NULL;
+    }
+    if (pool->bump_next == pool->bump_end && pool->free_list_head == NULL) {
+        size_t blocks = next_slab_blocks(pool);
+        if (blocks == 0 || growPool(pool, blocks) != LIB_OK) {
+            DIAG_TRACE_MSG("Pool is exhausted.");
+            STATS_INC(pool, exhaustion_events);
+            return NULL; // All blocks are in use and the pool may not grow
+        }
+    }
+
+    STATS_INC(pool, allocations);
+    STATS_INC(pool, in_use);
+    STATS_MAX(pool, peak_in_use, pool->stats.in_use);
+
+    // Hand out never-used blocks first, touching each page only now
+    if (pool->bump_next != pool->bump_end) {
+        void *block = pool->bump_next;
+        pool->bump_next += pool->block_size;
+        return block;
     }
 
     // Pop the head of the free list
@@ -72,9 +158,161 @@ void deallocate(MemPool *pool, void *ptr) {
     }
 
     // Push the deallocated block to the head of the free list
-    FreeNode *node = (FreeNode*)ptr;
-    node->next = pool->free_list_head;
-    pool->free_list_head = node;
+    STATS_INC(pool, deallocations);
+    STATS_DEC(pool, in_use);
+    push_free_block(pool, ptr);
+}
+
+void deallocateChain(MemPool *pool, void *first, void *last, size_t count) {
+    if (pool == NULL || first == NULL || last == NULL) {
+        return;
+    }
+    (void)count; // Only the counters need it
+    STATS_ADD(pool, deallocations, count);
+    STATS_SUB(pool, in_use, count);
+    ((FreeNode*)last)->next = pool->free_list_head;
+    pool->free_list_head = (FreeNode*)first;
+}
+
+int growPool(MemPool *pool, size_t num_blocks) {
+    if (pool == NULL || num_blocks == 0) {
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (pool->max_blocks > 0 && num_blocks > pool->max_blocks - pool->num_blocks) {
+        return LIB_ERR_EXHAUSTED;
+    }
+
+    // The slab header sits in front of the blocks and keeps them pointer-aligned
+    size_t header_size = align_size(sizeof(MemPoolSlab));
+    if (num_blocks > (SIZE_MAX - header_size) / pool->block_size) {
+        return LIB_ERR_NO_MEMORY;
+    }
+    MemPoolSlab *slab = (MemPoolSlab *)pool->allocator->alloc(pool->allocator->ctx, slab_bytes(pool, num_blocks));
+    if (slab == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate memory for memory pool slab.");
+        return LIB_ERR_NO_MEMORY;
+    }
+    slab->num_blocks = num_blocks;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+
+    // Retire what is left of the old bump region onto the free list
+    while (pool->bump_next != pool->bump_end) {
+        push_free_block(pool, pool->bump_next);
+        pool->bump_next += pool->block_size;
+    }
+    pool->bump_next = slab_blocks(slab);
+    pool->bump_end = pool->bump_next + num_blocks * pool->block_size;
+    STATS_INC(pool, slabs_added);
+    pool->num_blocks += num_blocks;
+    pool->total_size += num_blocks * pool->block_size;
+    return LIB_OK;
+}
+
+// qsort comparator ordering slabs by address
+static int compare_slab_address(const void *a, const void *b) {
+    uintptr_t left = (uintptr_t)*(MemPoolSlab *const *)a;
+    uintptr_t right = (uintptr_t)*(MemPoolSlab *const *)b;
+    return (left > right) - (left < right);
+}
+
+// Finds the slab containing 'ptr' in an address-sorted array, or -1
+static ptrdiff_t find_slab(MemPoolSlab **sorted, size_t count, size_t block_size, const void *ptr) {
+    size_t lo = 0;
+    size_t hi = count;
+    uintptr_t address = (uintptr_t)ptr;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        uintptr_t start = (uintptr_t)slab_blocks(sorted[mid]);
+        uintptr_t end = start + sorted[mid]->num_blocks * block_size;
+        if (address < start) {
+            hi = mid;
+        } else if (address >= end) {
+            lo = mid + 1;
+        } else {
+            return (ptrdiff_t)mid;
+        }
+    }
+    return -1;
+}
+
+size_t trimPool(MemPool *pool) {
+    if (pool == NULL || pool->slabs == NULL || pool->slabs->next == NULL) {
+        return 0; // Only the initial slab exists
+    }
+
+    // Candidate slabs are all but the initial (oldest, last in the chain) one
+    size_t candidates = 0;
+    for (MemPoolSlab *slab = pool->slabs; slab->next != NULL; slab = slab->next) {
+        candidates++;
+    }
+    MemPoolSlab **sorted = (MemPoolSlab **)malloc(candidates * sizeof(MemPoolSlab *));
+    size_t *free_counts = (size_t *)calloc(candidates, sizeof(size_t));
+    if (sorted == NULL || free_counts == NULL) {
+        free(sorted);
+        free(free_counts);
+        return 0; // Trimming is best effort
+    }
+    size_t i = 0;
+    for (MemPoolSlab *slab = pool->slabs; slab->next != NULL; slab = slab->next) {
+        sorted[i++] = slab;
+    }
+    qsort(sorted, candidates, sizeof(MemPoolSlab *), compare_slab_address);
+
+    // Pass 1: count free blocks per candidate slab, including never-used ones
+    if (pool->bump_next != pool->bump_end) {
+        ptrdiff_t owner = find_slab(sorted, candidates, pool->block_size, pool->bump_next);
+        if (owner >= 0) {
+            free_counts[owner] += (size_t)(pool->bump_end - pool->bump_next) / pool->block_size;
+        }
+    }
+    for (FreeNode *node = pool->free_list_head; node != NULL; node = node->next) {
+        ptrdiff_t owner = find_slab(sorted, candidates, pool->block_size, node);
+        if (owner >= 0) {
+            free_counts[owner]++;
+        }
+    }
+
+    // Pass 2: drop the blocks of fully free slabs from the free list
+    FreeNode **link = &pool->free_list_head;
+    while (*link != NULL) {
+        ptrdiff_t owner = find_slab(sorted, candidates, pool->block_size, *link);
+        if (owner >= 0 && free_counts[owner] == sorted[owner]->num_blocks) {
+            *link = (*link)->next;
+        } else {
+            link = &(*link)->next;
+        }
+    }
+
+    // Pass 3: unlink and free those slabs. Looking slabs up by their own
+    // address keeps the search from reading headers already freed here.
+    size_t released = 0;
+    MemPoolSlab **slab_link = &pool->slabs;
+    while ((*slab_link)->next != NULL) {
+        MemPoolSlab *slab = *slab_link;
+        MemPoolSlab **found = (MemPoolSlab **)bsearch(&slab, sorted, candidates, sizeof(MemPoolSlab *),
+                                                      compare_slab_address);
+        size_t owner = (size_t)(found - sorted);
+        if (free_counts[owner] == slab->num_blocks) {
+            if (pool->bump_end == slab_blocks(slab) + slab->num_blocks * pool->block_size) {
+                pool->bump_next = NULL; // The bump region goes away with its slab
+                pool->bump_end = NULL;
+            }
+            *slab_link = slab->next;
+            pool->num_blocks -= slab->num_blocks;
+            pool->total_size -= slab->num_blocks * pool->block_size;
+            released += slab->num_blocks * pool->block_size;
+            STATS_INC(pool, slabs_released);
+            pool->allocator->free(pool->allocator->ctx, slab, slab_bytes(pool, slab->num_blocks));
+        } else {
+            slab_link = &slab->next;
+        }
+    }
+
+    free(sorted);
+    free(free_counts);
+    DIAG_TRACE_MSG("Trimmed %zu bytes from memory pool.", released);
+    return released;
 }
 
 void destroyPool(MemPool *pool) {
@@ -82,19 +320,22 @@ void destroyPool(MemPool *pool) {
         return; // No-op
     }
 
-    if (pool->buffer != NULL) {
-        free(pool->buffer);
-        pool->buffer = NULL;
-    }
-
-    if (pool->free_list_head != NULL) {
-        free(pool->free_list_head);
-        pool->free_list_head = NULL;
+    // Free blocks live inside the slabs, so only the slabs are freed
+    MemPoolSlab *slab = pool->slabs;
+    while (slab != NULL) {
+        MemPoolSlab *next_slab = slab->next;
+        pool->allocator->free(pool->allocator->ctx, slab, slab_bytes(pool, slab->num_blocks));
+        slab = next_slab;
     }
+    pool->slabs = NULL;
+    pool->free_list_head = NULL;
+    pool->bump_next = NULL;
+    pool->bump_end = NULL;
     pool->total_size = 0;
     pool->block_size = 0;
-    free(pool);
+    const Allocator *allocator = pool->allocator;
+    allocator->free(allocator->ctx, pool, sizeof(MemPool));
     pool = NULL;
 
-    printf("Memory pool destroyed.\n");
-}
\ No newline at end of file
+    DIAG_TRACE_MSG("Memory pool destroyed.");
+}
@@ -0,0 +1,114 @@
+#include "pool_alloc.h"
+#include "mempool.h"
+#include "diag_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Aim for slabs of about this many bytes, but never fewer than MIN_SLAB_BLOCKS blocks
+#define SLAB_BYTES (64 * 1024)
+#define MIN_SLAB_BLOCKS 8
+
+static MemPool *class_pools[POOL_ALLOC_NUM_CLASSES];
+
+// Maps a request size to its class index; only valid for size <= POOL_ALLOC_MAX_CLASS
+static int size_class(size_t size) {
+    int index = 0;
+    size_t class_size = POOL_ALLOC_MIN_CLASS;
+    while (class_size < size) {
+        class_size <<= 1;
+        index++;
+    }
+    return index;
+}
+
+static size_t class_size(int index) {
+    return (size_t)POOL_ALLOC_MIN_CLASS << index;
+}
+
+static MemPool* class_pool(int index) {
+    if (class_pools[index] == NULL) {
+        size_t block_size = class_size(index);
+        size_t slab_blocks = SLAB_BYTES / block_size;
+        if (slab_blocks < MIN_SLAB_BLOCKS) {
+            slab_blocks = MIN_SLAB_BLOCKS;
+        }
+        MemPoolConfig config = { slab_blocks, block_size, POOL_GROWTH_FIXED, slab_blocks, 0, NULL };
+        class_pools[index] = createPoolWithConfig(&config);
+    }
+    return class_pools[index];
+}
+
+void* pool_malloc(size_t size) {
+    if (size > POOL_ALLOC_MAX_CLASS) {
+        return malloc(size);
+    }
+    MemPool *pool = class_pool(size_class(size));
+    if (pool == NULL) {
+        DIAG_ERROR_MSG("Failed to create size-class pool for %zu bytes.", size);
+        return NULL;
+    }
+    return allocate(pool);
+}
+
+void pool_free(void *ptr, size_t size) {
+    if (ptr == NULL) {
+        return;
+    }
+    if (size > POOL_ALLOC_MAX_CLASS) {
+        free(ptr);
+        return;
+    }
+    deallocate(class_pools[size_class(size)], ptr);
+}
+
+void* pool_realloc(void *ptr, size_t old_size, size_t new_size) {
+    if (ptr == NULL) {
+        return pool_malloc(new_size);
+    }
+    int old_pooled = old_size <= POOL_ALLOC_MAX_CLASS;
+    int new_pooled = new_size <= POOL_ALLOC_MAX_CLASS;
+    if (!old_pooled && !new_pooled) {
+        return realloc(ptr, new_size); // Both sides belong to malloc
+    }
+    if (old_pooled && new_pooled && size_class(old_size) == size_class(new_size)) {
+        return ptr; // Still fits in the same class
+    }
+    void *moved = pool_malloc(new_size);
+    if (moved == NULL) {
+        return NULL;
+    }
+    memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    pool_free(ptr, old_size);
+    return moved;
+}
+
+size_t pool_trim(void) {
+    size_t released = 0;
+    for (int i = 0; i < POOL_ALLOC_NUM_CLASSES; ++i) {
+        released += trimPool(class_pools[i]);
+    }
+    return released;
+}
+
+static void* pool_allocator_alloc(void *ctx, size_t size) {
+    (void)ctx;
+    return pool_malloc(size);
+}
+
+static void* pool_allocator_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    (void)ctx;
+    return pool_realloc(ptr, old_size, new_size);
+}
+
+static void pool_allocator_free(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    pool_free(ptr, size);
+}
+
+static const Allocator size_class_allocator = {
+    pool_allocator_alloc, pool_allocator_realloc, pool_allocator_free, NULL
+};
+
+const Allocator* pool_allocator(void) {
+    return &size_class_allocator;
+}
@@ -0,0 +1,242 @@
+#include "ring_queue.h"
+#include "diag_internal.h"
+#include <stdint.h> // For intptr_t, SIZE_MAX
+#include <stdlib.h>
+#include <string.h>
+
+// Space reserved for the sequence word at the front of an MPMC slot
+#define SEQ_SIZE sizeof(size_t)
+
+static inline char* slot_at(const RingQueue *queue, size_t position) {
+    return queue->slots + (position & queue->mask) * queue->slot_size;
+}
+
+static inline _Atomic size_t* slot_seq(char *slot) {
+    return (_Atomic size_t *)slot;
+}
+
+// --- SPSC: one producer, one consumer ---
+
+// Copies 'count' elements into consecutive positions starting at 'position',
+// wrapping once at the end of the buffer.
+static void spsc_copy_in(RingQueue *queue, size_t position, const char *src, size_t count) {
+    size_t index = position & queue->mask;
+    size_t first = queue->capacity - index < count ? queue->capacity - index : count;
+    memcpy(queue->slots + index * queue->element_size, src, first * queue->element_size);
+    memcpy(queue->slots, src + first * queue->element_size, (count - first) * queue->element_size);
+}
+
+static void spsc_copy_out(const RingQueue *queue, size_t position, char *dst, size_t count) {
+    size_t index = position & queue->mask;
+    size_t first = queue->capacity - index < count ? queue->capacity - index : count;
+    memcpy(dst, queue->slots + index * queue->element_size, first * queue->element_size);
+    memcpy(dst + first * queue->element_size, queue->slots, (count - first) * queue->element_size);
+}
+
+static size_t spsc_enqueue(RingQueue *queue, const char *src, size_t count) {
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed); // Only we write it
+    size_t space = queue->capacity - (tail - queue->cached_head);
+    if (space < count) {
+        queue->cached_head = atomic_load_explicit(&queue->head, memory_order_acquire);
+        space = queue->capacity - (tail - queue->cached_head);
+        if (space == 0) {
+            return 0;
+        }
+        count = space < count ? space : count;
+    }
+    spsc_copy_in(queue, tail, src, count);
+    atomic_store_explicit(&queue->tail, tail + count, memory_order_release);
+    return count;
+}
+
+static size_t spsc_dequeue(RingQueue *queue, char *dst, size_t max) {
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed); // Only we write it
+    size_t available = queue->cached_tail - head;
+    if (available < max) {
+        queue->cached_tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        available = queue->cached_tail - head;
+        if (available == 0) {
+            return 0;
+        }
+        max = available < max ? available : max;
+    }
+    spsc_copy_out(queue, head, dst, max);
+    atomic_store_explicit(&queue->head, head + max, memory_order_release);
+    return max;
+}
+
+// --- MPMC: Vyukov sequence numbers ---
+
+static size_t mpmc_enqueue(RingQueue *queue, const char *src, size_t count) {
+    size_t done = 0;
+    while (done < count) {
+        size_t position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+        // Count the leading slots that are free for this lap
+        size_t run = 0;
+        size_t seq = 0;
+        while (run < count - done) {
+            seq = atomic_load_explicit(slot_seq(slot_at(queue, position + run)), memory_order_acquire);
+            if (seq != position + run) {
+                break;
+            }
+            run++;
+        }
+        if (run == 0) {
+            if ((intptr_t)(seq - position) < 0) {
+                break; // The slot still holds last lap's element: full
+            }
+            continue; // Another producer claimed 'position'; reload tail
+        }
+        // The slots stay free until whoever owns their positions claims them,
+        // so they are still ours if 'tail' has not moved.
+        if (!atomic_compare_exchange_weak_explicit(&queue->tail, &position, position + run,
+                                                   memory_order_relaxed, memory_order_relaxed)) {
+            continue;
+        }
+        for (size_t i = 0; i < run; ++i) {
+            char *slot = slot_at(queue, position + i);
+            memcpy(slot + SEQ_SIZE, src + (done + i) * queue->element_size, queue->element_size);
+            atomic_store_explicit(slot_seq(slot), position + i + 1, memory_order_release);
+        }
+        done += run;
+    }
+    return done;
+}
+
+static size_t mpmc_dequeue(RingQueue *queue, char *dst, size_t max) {
+    size_t done = 0;
+    while (done < max) {
+        size_t position = atomic_load_explicit(&queue->head, memory_order_relaxed);
+        // Count the leading slots whose elements have been published
+        size_t run = 0;
+        size_t seq = 0;
+        while (run < max - done) {
+            seq = atomic_load_explicit(slot_seq(slot_at(queue, position + run)), memory_order_acquire);
+            if (seq != position + run + 1) {
+                break;
+            }
+            run++;
+        }
+        if (run == 0) {
+            if ((intptr_t)(seq - (position + 1)) < 0) {
+                break; // Nothing published at 'position' yet: empty
+            }
+            continue; // Another consumer took 'position'; reload head
+        }
+        if (!atomic_compare_exchange_weak_explicit(&queue->head, &position, position + run,
+                                                   memory_order_relaxed, memory_order_relaxed)) {
+            continue;
+        }
+        for (size_t i = 0; i < run; ++i) {
+            char *slot = slot_at(queue, position + i);
+            memcpy(dst + (done + i) * queue->element_size, slot + SEQ_SIZE, queue->element_size);
+            // Free the slot for the producer of the same index one lap later
+            atomic_store_explicit(slot_seq(slot), position + i + queue->capacity, memory_order_release);
+        }
+        done += run;
+    }
+    return done;
+}
+
+// --- Public API ---
+
+RingQueue* ring_queue_create(size_t capacity, size_t element_size, RingQueueMode mode) {
+    if (element_size == 0 || (mode != RING_QUEUE_SPSC && mode != RING_QUEUE_MPMC)) {
+        DIAG_ERROR_MSG("Invalid element size %zu or queue mode %d.", element_size, (int)mode);
+        return NULL;
+    }
+    // Two slots at least: with one, a freed MPMC slot would look published
+    size_t rounded = 2;
+    while (rounded < capacity) {
+        if (rounded > SIZE_MAX / 2) {
+            DIAG_ERROR_MSG("Queue capacity %zu is too large.", capacity);
+            return NULL;
+        }
+        rounded *= 2;
+    }
+    size_t slot_size = element_size;
+    if (mode == RING_QUEUE_MPMC) {
+        // Keep every sequence word aligned
+        slot_size = SEQ_SIZE + (element_size + SEQ_SIZE - 1) / SEQ_SIZE * SEQ_SIZE;
+    }
+    if (slot_size > SIZE_MAX / rounded) {
+        DIAG_ERROR_MSG("Queue of %zu x %zu bytes is too large.", rounded, slot_size);
+        return NULL;
+    }
+
+    RingQueue *queue = (RingQueue *)aligned_alloc(64, (sizeof(RingQueue) + 63) & ~(size_t)63);
+    if (queue == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate memory for RingQueue structure.");
+        return NULL;
+    }
+    queue->slots = (char *)malloc(rounded * slot_size);
+    if (queue->slots == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate %zu bytes for queue slots.", rounded * slot_size);
+        free(queue);
+        return NULL;
+    }
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    queue->cached_head = 0;
+    queue->cached_tail = 0;
+    queue->mode = mode;
+    queue->capacity = rounded;
+    queue->mask = rounded - 1;
+    queue->element_size = element_size;
+    queue->slot_size = slot_size;
+    if (mode == RING_QUEUE_MPMC) {
+        for (size_t i = 0; i < rounded; ++i) {
+            atomic_init(slot_seq(queue->slots + i * slot_size), i); // Free for lap 0
+        }
+    }
+    DIAG_TRACE_MSG("Ring queue created with %zu slots of %zu bytes.", rounded, slot_size);
+    return queue;
+}
+
+int ring_queue_enqueue(RingQueue *queue, const void *element) {
+    if (queue->mode == RING_QUEUE_SPSC) {
+        return (int)spsc_enqueue(queue, (const char *)element, 1);
+    }
+    return (int)mpmc_enqueue(queue, (const char *)element, 1);
+}
+
+int ring_queue_dequeue(RingQueue *queue, void *out) {
+    if (queue->mode == RING_QUEUE_SPSC) {
+        return (int)spsc_dequeue(queue, (char *)out, 1);
+    }
+    return (int)mpmc_dequeue(queue, (char *)out, 1);
+}
+
+size_t ring_queue_enqueue_batch(RingQueue *queue, const void *elements, size_t count) {
+    if (queue->mode == RING_QUEUE_SPSC) {
+        return spsc_enqueue(queue, (const char *)elements, count);
+    }
+    return mpmc_enqueue(queue, (const char *)elements, count);
+}
+
+size_t ring_queue_dequeue_batch(RingQueue *queue, void *out, size_t max) {
+    if (queue->mode == RING_QUEUE_SPSC) {
+        return spsc_dequeue(queue, (char *)out, max);
+    }
+    return mpmc_dequeue(queue, (char *)out, max);
+}
+
+size_t ring_queue_size(const RingQueue *queue) {
+    // Head first: 'tail' read afterwards can only be further ahead of it
+    size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    size_t size = tail - head;
+    return size < queue->capacity ? size : queue->capacity;
+}
+
+size_t ring_queue_capacity(const RingQueue *queue) {
+    return queue->capacity;
+}
+
+void ring_queue_destroy(RingQueue *queue) {
+    if (queue == NULL) {
+        return;
+    }
+    free(queue->slots);
+    free(queue);
+}
@@ -0,0 +1,209 @@
+#include "skip_list.h"
+#include "diag_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Nodes in the first slab of the height-1 pool; taller pools start smaller
+#define SKIP_LIST_FIRST_SLAB 64
+#define SKIP_LIST_MIN_SLAB 4
+
+static inline size_t node_size(unsigned int height) {
+    return sizeof(SkipNode) + height * sizeof(SkipNode *);
+}
+
+// Draws a tower height: each extra level is kept with probability 1/4,
+// using two bits of one xorshift32 draw per level.
+static unsigned int random_height(SkipList *list) {
+    uint32_t x = list->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    list->rng = x;
+    unsigned int height = 1;
+    while ((x & 3) == 0 && height < SKIP_LIST_MAX_LEVEL) {
+        height++;
+        x >>= 2;
+    }
+    return height;
+}
+
+static SkipNode* allocate_node(SkipList *list, unsigned int height) {
+    MemPool *pool = list->pools[height - 1];
+    if (pool == NULL) {
+        // Each height is about a quarter as common as the one below
+        size_t blocks = (size_t)SKIP_LIST_FIRST_SLAB >> (2 * (height - 1));
+        MemPoolConfig config = { blocks > SKIP_LIST_MIN_SLAB ? blocks : SKIP_LIST_MIN_SLAB,
+                                 node_size(height), POOL_GROWTH_DOUBLE, 0, 0, NULL };
+        pool = createPoolWithConfig(&config);
+        if (pool == NULL) {
+            return NULL;
+        }
+        list->pools[height - 1] = pool;
+    }
+    return (SkipNode *)allocate(pool);
+}
+
+// The link on 'level' that follows 'prev', or the head of that level when 'prev' is NULL
+static inline SkipNode** link_after(SkipList *list, SkipNode *prev, unsigned int level) {
+    return prev != NULL ? &prev->next[level] : &list->head[level];
+}
+
+// Fills prev[l], for every level in use, with the last node on level l that
+// goes before 'key' (NULL for the head). With 'after_equal' set, nodes holding
+// 'key' go before it too, so an insert lands after them.
+static void find_predecessors(const SkipList *list, int key, int after_equal, SkipNode **prev) {
+    SkipNode *node = NULL;
+    SkipNode *const *links = list->head; // Tower of 'node', or the heads
+    for (unsigned int level = list->level; level-- > 0;) {
+        SkipNode *next = links[level];
+        while (next != NULL && (next->key < key || (after_equal && next->key == key))) {
+            node = next;
+            links = next->next;
+            next = links[level];
+        }
+        prev[level] = node;
+    }
+}
+
+static SkipNode* lower_bound(const SkipList *list, int key) {
+    SkipNode *const *links = list->head;
+    for (unsigned int level = list->level; level-- > 0;) {
+        while (links[level] != NULL && links[level]->key < key) {
+            links = links[level]->next;
+        }
+    }
+    return links[0];
+}
+
+// --- Public API ---
+
+SkipList* skiplist_create(void) {
+    SkipList *list = (SkipList *)malloc(sizeof(SkipList));
+    if (list == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate memory for SkipList structure.");
+        return NULL;
+    }
+    memset(list, 0, sizeof(SkipList));
+    list->rng = 0x9E3779B9u; // Any nonzero seed; heights do not depend on the keys
+    DIAG_TRACE_MSG("Skip list created.");
+    return list;
+}
+
+int skiplist_insert(SkipList *list, int key, void *value) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("Skip list is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    unsigned int height = random_height(list);
+    SkipNode *node = allocate_node(list, height);
+    if (node == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate a skip list node of height %u.", height);
+        return LIB_ERR_NO_MEMORY;
+    }
+    node->key = key;
+    node->height = height;
+    node->value = value;
+
+    SkipNode *prev[SKIP_LIST_MAX_LEVEL];
+    if (list->tail[0] != NULL && key >= list->tail[0]->key) {
+        // Not below the maximum: the node goes last on every level, no search needed
+        memcpy(prev, list->tail, height * sizeof(SkipNode *));
+    } else {
+        find_predecessors(list, key, 1, prev);
+        for (unsigned int level = list->level; level < height; ++level) {
+            prev[level] = NULL; // Levels not in use yet start at the head
+        }
+    }
+    for (unsigned int level = 0; level < height; ++level) {
+        SkipNode **link = link_after(list, prev[level], level);
+        node->next[level] = *link;
+        *link = node;
+        if (node->next[level] == NULL) {
+            list->tail[level] = node;
+        }
+    }
+    if (height > list->level) {
+        list->level = height;
+    }
+    list->size++;
+    return LIB_OK;
+}
+
+SkipNode* skiplist_find(const SkipList *list, int key) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("Skip list is NULL.");
+        return NULL;
+    }
+    SkipNode *node = lower_bound(list, key);
+    return node != NULL && node->key == key ? node : NULL;
+}
+
+int skiplist_delete(SkipList *list, int key) {
+    if (list == NULL || list->size == 0) {
+        DIAG_TRACE_MSG("Skip list is empty or NULL. No deletion.");
+        return 0;
+    }
+    SkipNode *prev[SKIP_LIST_MAX_LEVEL];
+    find_predecessors(list, key, 0, prev);
+    SkipNode *node = *link_after(list, prev[0], 0);
+    if (node == NULL || node->key != key) {
+        DIAG_TRACE_MSG("Key %d not found. No deletion.", key);
+        return 0;
+    }
+    // The first node holding 'key' directly follows the predecessor on each of its levels
+    for (unsigned int level = 0; level < node->height; ++level) {
+        *link_after(list, prev[level], level) = node->next[level];
+        if (list->tail[level] == node) {
+            list->tail[level] = prev[level];
+        }
+    }
+    while (list->level > 0 && list->head[list->level - 1] == NULL) {
+        list->level--;
+    }
+    deallocate(list->pools[node->height - 1], node);
+    list->size--;
+    return 1;
+}
+
+SkipNode* skiplist_lower_bound(const SkipList *list, int key) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("Skip list is NULL.");
+        return NULL;
+    }
+    return lower_bound(list, key);
+}
+
+size_t skiplist_range(const SkipList *list, int low, int high, SkipListVisitFn visit, void *ctx) {
+    if (list == NULL || visit == NULL) {
+        DIAG_ERROR_MSG("Skip list or visitor is NULL.");
+        return 0;
+    }
+    size_t visited = 0;
+    for (SkipNode *node = lower_bound(list, low); node != NULL && node->key <= high; node = node->next[0]) {
+        visited++;
+        if (visit(node, ctx) != 0) {
+            break;
+        }
+    }
+    return visited;
+}
+
+size_t skiplist_size(const SkipList *list) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("Skip list is NULL.");
+        return 0;
+    }
+    return list->size;
+}
+
+void skiplist_destroy(SkipList *list) {
+    if (list == NULL) {
+        return;
+    }
+    // Every node lives in one of the pools: release them wholesale
+    for (unsigned int height = 1; height <= SKIP_LIST_MAX_LEVEL; ++height) {
+        destroyPool(list->pools[height - 1]);
+    }
+    free(list);
+    DIAG_TRACE_MSG("Skip list destroyed and memory deallocated.");
+}
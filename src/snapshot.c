@@ -0,0 +1,358 @@
+#define _POSIX_C_SOURCE 200809L // For fileno
+#include "snapshot.h"
+#include "diag_internal.h" // For DIAG_ERROR_MSG
+#include <stddef.h> // For offsetof
+#include <stdint.h> // For uint32_t, uint64_t, SIZE_MAX
+#include <stdio.h>  // For FILE, fopen, fread, fwrite
+#include <stdlib.h> // For malloc, free
+#include <string.h> // For memcpy, memcmp
+#include <sys/stat.h> // For fstat
+
+#define SNAPSHOT_MAGIC "MYCSNAP\0"
+#define SNAPSHOT_VERSION 1u
+#define SNAPSHOT_BYTE_ORDER 0x01020304u // Reads back byte-swapped on an other-endian machine
+#define SNAPSHOT_BLOCK_BYTES ((size_t)1 << 20) // Unit of every read and write; a multiple of 16
+
+enum {
+    SNAPSHOT_KIND_VECTOR = 1,
+    SNAPSHOT_KIND_LIST = 2
+};
+
+// On-disk header; every field is naturally aligned, so there is no padding.
+typedef struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t kind;
+    uint32_t byte_order;
+    uint32_t reserved;        // Written as 0
+    uint64_t element_size;
+    uint64_t count;
+    uint64_t header_checksum; // Checksum of every field above
+} SnapshotHeader;
+
+// Fletcher-style running sums over 32-bit words: 'a' catches changed words
+// and 'b' (the sum of the running 'a') catches reordered ones. The 64-bit
+// accumulators simply wrap. Words are dealt round-robin to four independent
+// lanes, so the two adds per word do not form one long dependency chain.
+#define CHECKSUM_LANES 4
+
+typedef struct Checksum {
+    uint64_t a[CHECKSUM_LANES];
+    uint64_t b[CHECKSUM_LANES];
+} Checksum;
+
+// 'bytes' must be a multiple of 16 (one word per lane) except in the last
+// call for a stream, whose final partial word is zero-padded.
+static void checksum_update(Checksum *sum, const void *data, size_t bytes) {
+    const unsigned char *p = (const unsigned char *)data;
+    size_t words = bytes / 4;
+    size_t i = 0;
+    for (; i + CHECKSUM_LANES <= words; i += CHECKSUM_LANES) {
+        for (int lane = 0; lane < CHECKSUM_LANES; ++lane) {
+            uint32_t word;
+            memcpy(&word, p + (i + (size_t)lane) * 4, sizeof(word));
+            sum->a[lane] += word;
+            sum->b[lane] += sum->a[lane];
+        }
+    }
+    // Fewer than CHECKSUM_LANES words remain; they go to the lanes in order
+    size_t lane = 0;
+    for (; i < words; ++i, ++lane) {
+        uint32_t word;
+        memcpy(&word, p + i * 4, sizeof(word));
+        sum->a[lane & (CHECKSUM_LANES - 1)] += word;
+        sum->b[lane & (CHECKSUM_LANES - 1)] += sum->a[lane & (CHECKSUM_LANES - 1)];
+    }
+    lane &= CHECKSUM_LANES - 1;
+    size_t tail = bytes % 4;
+    if (tail > 0) {
+        uint32_t word = 0;
+        memcpy(&word, p + words * 4, tail);
+        sum->a[lane] += word;
+        sum->b[lane] += sum->a[lane];
+    }
+}
+
+static uint64_t checksum_value(const Checksum *sum) {
+    uint64_t value = 0;
+    for (int lane = 0; lane < CHECKSUM_LANES; ++lane) {
+        uint64_t b = sum->b[lane];
+        value = (value << 7 | value >> 57) ^ sum->a[lane] ^ (b << 32 | b >> 32);
+    }
+    return value;
+}
+
+static uint64_t header_checksum(const SnapshotHeader *header) {
+    Checksum sum = { { 0 }, { 0 } };
+    checksum_update(&sum, header, offsetof(SnapshotHeader, header_checksum));
+    return checksum_value(&sum);
+}
+
+static int write_header(FILE *file, uint32_t kind, size_t element_size, size_t count) {
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.kind = kind;
+    header.byte_order = SNAPSHOT_BYTE_ORDER;
+    header.element_size = element_size;
+    header.count = count;
+    header.header_checksum = header_checksum(&header);
+    if (fwrite(&header, sizeof(header), 1, file) != 1) {
+        DIAG_ERROR_MSG("Failed to write the snapshot header.");
+        return LIB_ERR_IO;
+    }
+    return LIB_OK;
+}
+
+// Reads 'bytes' bytes into 'buffer' and folds them into 'sum' (which may be NULL).
+static int read_block(FILE *file, void *buffer, size_t bytes, Checksum *sum) {
+    if (fread(buffer, 1, bytes, file) != bytes) {
+        if (ferror(file)) {
+            DIAG_ERROR_MSG("Failed to read the snapshot.");
+            return LIB_ERR_IO;
+        }
+        DIAG_ERROR_MSG("Snapshot is truncated.");
+        return LIB_ERR_CORRUPT;
+    }
+    if (sum != NULL) {
+        checksum_update(sum, buffer, bytes);
+    }
+    return LIB_OK;
+}
+
+static int write_block(FILE *file, const void *buffer, size_t bytes, Checksum *sum) {
+    checksum_update(sum, buffer, bytes);
+    if (fwrite(buffer, 1, bytes, file) != bytes) {
+        DIAG_ERROR_MSG("Failed to write the snapshot.");
+        return LIB_ERR_IO;
+    }
+    return LIB_OK;
+}
+
+// Reads and validates the header; on success the element count and size are
+// usable, and a regular file is long enough to hold that many elements.
+static int read_header(FILE *file, uint32_t kind, SnapshotHeader *header) {
+    int status = read_block(file, header, sizeof(*header), NULL);
+    if (status != LIB_OK) {
+        return status;
+    }
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != SNAPSHOT_VERSION ||
+        header->byte_order != SNAPSHOT_BYTE_ORDER ||
+        header->header_checksum != header_checksum(header)) {
+        DIAG_ERROR_MSG("Not a snapshot of a supported version and byte order, or its header is damaged.");
+        return LIB_ERR_CORRUPT;
+    }
+    if (header->kind != kind) {
+        DIAG_ERROR_MSG("Snapshot holds container kind %u, expected %u.", (unsigned)header->kind, (unsigned)kind);
+        return LIB_ERR_CORRUPT;
+    }
+    if (header->element_size == 0 || header->element_size > SIZE_MAX || header->count > SIZE_MAX ||
+        header->count > SIZE_MAX / header->element_size) {
+        DIAG_ERROR_MSG("Snapshot element size or count is out of range.");
+        return LIB_ERR_CORRUPT;
+    }
+    // The loaders size their container from 'count' before reading the data,
+    // so a truncated file must not get that far
+    struct stat st;
+    if (fstat(fileno(file), &st) == 0 && S_ISREG(st.st_mode)) {
+        uint64_t overhead = sizeof(SnapshotHeader) + sizeof(uint64_t); // Header and trailer
+        uint64_t file_size = (uint64_t)st.st_size;
+        if (file_size < overhead || header->count * header->element_size > file_size - overhead) {
+            DIAG_ERROR_MSG("Snapshot is truncated: %llu elements do not fit in %llu bytes.",
+                           (unsigned long long)header->count, (unsigned long long)file_size);
+            return LIB_ERR_CORRUPT;
+        }
+    }
+    return LIB_OK;
+}
+
+static int write_trailer(FILE *file, const Checksum *sum) {
+    uint64_t value = checksum_value(sum);
+    if (fwrite(&value, sizeof(value), 1, file) != 1) {
+        DIAG_ERROR_MSG("Failed to write the snapshot checksum.");
+        return LIB_ERR_IO;
+    }
+    return LIB_OK;
+}
+
+static int check_trailer(FILE *file, const Checksum *sum) {
+    uint64_t stored;
+    int status = read_block(file, &stored, sizeof(stored), NULL);
+    if (status != LIB_OK) {
+        return status;
+    }
+    if (stored != checksum_value(sum)) {
+        DIAG_ERROR_MSG("Snapshot checksum mismatch.");
+        return LIB_ERR_CORRUPT;
+    }
+    return LIB_OK;
+}
+
+// Closes a file being written; a failed close means buffered data was lost.
+static int finish_write(FILE *file, int status) {
+    if (fclose(file) != 0 && status == LIB_OK) {
+        DIAG_ERROR_MSG("Failed to flush the snapshot.");
+        status = LIB_ERR_IO;
+    }
+    return status;
+}
+
+int vector_save(const Vector *vec, const char *path) {
+    if (vec == NULL || path == NULL) {
+        DIAG_ERROR_MSG("Vector or path is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        DIAG_ERROR_MSG("Cannot create %s.", path);
+        return LIB_ERR_IO;
+    }
+    int status = write_header(file, SNAPSHOT_KIND_VECTOR, vec->element_size, vec->size);
+    Checksum sum = { { 0 }, { 0 } };
+    // The elements are already contiguous: write them straight from the buffer
+    size_t total = vec->size * vec->element_size;
+    for (size_t offset = 0; status == LIB_OK && offset < total; offset += SNAPSHOT_BLOCK_BYTES) {
+        size_t bytes = total - offset < SNAPSHOT_BLOCK_BYTES ? total - offset : SNAPSHOT_BLOCK_BYTES;
+        status = write_block(file, vec->data + offset, bytes, &sum);
+    }
+    if (status == LIB_OK) {
+        status = write_trailer(file, &sum);
+    }
+    return finish_write(file, status);
+}
+
+int vector_load(const char *path, Vector **out) {
+    if (path == NULL || out == NULL) {
+        DIAG_ERROR_MSG("Path or output pointer is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        DIAG_ERROR_MSG("Cannot open %s.", path);
+        return LIB_ERR_IO;
+    }
+    SnapshotHeader header;
+    int status = read_header(file, SNAPSHOT_KIND_VECTOR, &header);
+    Vector *vec = NULL;
+    if (status == LIB_OK) {
+        size_t count = (size_t)header.count;
+        vec = vector_create(count > 0 ? count : 1, (size_t)header.element_size);
+        status = vec != NULL ? LIB_OK : LIB_ERR_NO_MEMORY;
+    }
+    Checksum sum = { { 0 }, { 0 } };
+    if (status == LIB_OK) {
+        // Read directly into the vector's buffer; no staging copy
+        size_t total = (size_t)header.count * (size_t)header.element_size;
+        for (size_t offset = 0; status == LIB_OK && offset < total; offset += SNAPSHOT_BLOCK_BYTES) {
+            size_t bytes = total - offset < SNAPSHOT_BLOCK_BYTES ? total - offset : SNAPSHOT_BLOCK_BYTES;
+            status = read_block(file, vec->data + offset, bytes, &sum);
+        }
+    }
+    if (status == LIB_OK) {
+        status = check_trailer(file, &sum);
+    }
+    fclose(file);
+    if (status != LIB_OK) {
+        if (vec != NULL) {
+            vector_destroy(vec);
+        }
+        return status;
+    }
+    vec->size = (size_t)header.count;
+    *out = vec;
+    return LIB_OK;
+}
+
+int list_save(const LinkedList *list, const char *path) {
+    if (list == NULL || path == NULL) {
+        DIAG_ERROR_MSG("List or path is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (list->payload_size != sizeof(int)) {
+        DIAG_ERROR_MSG("Only int lists can be saved, not %zu-byte payloads.", list->payload_size);
+        return LIB_ERR_INVALID_ARG;
+    }
+    int *block = (int *)malloc(SNAPSHOT_BLOCK_BYTES);
+    if (block == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate the snapshot buffer.");
+        return LIB_ERR_NO_MEMORY;
+    }
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        DIAG_ERROR_MSG("Cannot create %s.", path);
+        free(block);
+        return LIB_ERR_IO;
+    }
+    int status = write_header(file, SNAPSHOT_KIND_LIST, sizeof(int), list->size);
+    Checksum sum = { { 0 }, { 0 } };
+    // Gather the values into a block, then write it with one call
+    const size_t per_block = SNAPSHOT_BLOCK_BYTES / sizeof(int);
+    size_t filled = 0;
+    for (const Node *current = list->head; status == LIB_OK && current != NULL; current = current->next) {
+        block[filled++] = current->data;
+        if (filled == per_block) {
+            status = write_block(file, block, filled * sizeof(int), &sum);
+            filled = 0;
+        }
+    }
+    if (status == LIB_OK && filled > 0) {
+        status = write_block(file, block, filled * sizeof(int), &sum);
+    }
+    if (status == LIB_OK) {
+        status = write_trailer(file, &sum);
+    }
+    free(block);
+    return finish_write(file, status);
+}
+
+int list_load(const char *path, LinkedList **out) {
+    if (path == NULL || out == NULL) {
+        DIAG_ERROR_MSG("Path or output pointer is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        DIAG_ERROR_MSG("Cannot open %s.", path);
+        return LIB_ERR_IO;
+    }
+    SnapshotHeader header;
+    int status = read_header(file, SNAPSHOT_KIND_LIST, &header);
+    if (status == LIB_OK && header.element_size != sizeof(int)) {
+        DIAG_ERROR_MSG("List snapshot holds %llu-byte values, not %zu.",
+                       (unsigned long long)header.element_size, sizeof(int));
+        status = LIB_ERR_CORRUPT;
+    }
+    int *block = NULL;
+    LinkedList *list = NULL;
+    if (status == LIB_OK) {
+        size_t count = (size_t)header.count;
+        block = (int *)malloc(SNAPSHOT_BLOCK_BYTES);
+        // One slab sized to the whole list: nodes end up contiguous and in order
+        list = createPooledList(count > 0 ? count : 1);
+        status = block != NULL && list != NULL ? LIB_OK : LIB_ERR_NO_MEMORY;
+    }
+    Checksum sum = { { 0 }, { 0 } };
+    const size_t per_block = SNAPSHOT_BLOCK_BYTES / sizeof(int);
+    size_t remaining = status == LIB_OK ? (size_t)header.count : 0;
+    while (status == LIB_OK && remaining > 0) {
+        size_t n = remaining < per_block ? remaining : per_block;
+        status = read_block(file, block, n * sizeof(int), &sum);
+        for (size_t i = 0; status == LIB_OK && i < n; ++i) {
+            status = insertAtEnd(list, block[i]);
+        }
+        remaining -= n;
+    }
+    if (status == LIB_OK) {
+        status = check_trailer(file, &sum);
+    }
+    fclose(file);
+    free(block);
+    if (status != LIB_OK) {
+        destroyList(list);
+        return status;
+    }
+    *out = list;
+    return LIB_OK;
+}
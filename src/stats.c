@@ -0,0 +1,116 @@
+#include "stats.h"
+#include "vector.h"
+#include "linked_list.h"
+#include "mempool.h"
+#include <string.h>
+
+int stats_enabled(void) {
+#ifdef MY_C_LIB_STATS
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+void vector_get_stats(const Vector *vec, VectorStats *out) {
+    if (out == NULL) {
+        return;
+    }
+    memset(out, 0, sizeof(*out));
+#ifdef MY_C_LIB_STATS
+    if (vec != NULL) {
+        *out = vec->stats;
+    }
+#else
+    (void)vec;
+#endif
+}
+
+void list_get_stats(const LinkedList *list, ListStats *out) {
+    if (out == NULL) {
+        return;
+    }
+    memset(out, 0, sizeof(*out));
+#ifdef MY_C_LIB_STATS
+    if (list != NULL) {
+        *out = list->stats;
+    }
+#else
+    (void)list;
+#endif
+}
+
+void pool_get_stats(const MemPool *pool, PoolStats *out) {
+    if (out == NULL) {
+        return;
+    }
+    memset(out, 0, sizeof(*out));
+#ifdef MY_C_LIB_STATS
+    if (pool != NULL) {
+        *out = pool->stats;
+    }
+#else
+    (void)pool;
+#endif
+}
+
+// Writes the name as a JSON string, escaping quotes, backslashes and control characters
+static void write_json_string(FILE *out, const char *text) {
+    fputc('"', out);
+    for (const char *c = text != NULL ? text : ""; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(out, "\\%c", *c);
+        } else if ((unsigned char)*c < 0x20) {
+            fprintf(out, "\\u%04x", (unsigned char)*c);
+        } else {
+            fputc(*c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+void vector_stats_dump_json(FILE *out, const char *name, const Vector *vec) {
+    if (out == NULL || vec == NULL) {
+        return;
+    }
+    VectorStats s;
+    vector_get_stats(vec, &s);
+    fprintf(out, "{\"type\":\"vector\",\"name\":");
+    write_json_string(out, name);
+    fprintf(out, ",\"stats_enabled\":%s,\"size\":%zu,\"capacity\":%zu,\"element_size\":%zu,"
+                 "\"allocations\":%zu,\"resizes\":%zu,\"bytes_allocated\":%zu,\"current_bytes\":%zu,"
+                 "\"peak_bytes\":%zu,\"peak_size\":%zu}\n",
+            stats_enabled() ? "true" : "false", vec->size, vec->capacity, vec->element_size,
+            s.allocations, s.resizes, s.bytes_allocated, s.current_bytes, s.peak_bytes, s.peak_size);
+}
+
+void list_stats_dump_json(FILE *out, const char *name, const LinkedList *list) {
+    if (out == NULL || list == NULL) {
+        return;
+    }
+    ListStats s;
+    list_get_stats(list, &s);
+    fprintf(out, "{\"type\":\"list\",\"name\":");
+    write_json_string(out, name);
+    fprintf(out, ",\"stats_enabled\":%s,\"size\":%zu,\"pooled\":%s,\"node_allocations\":%zu,"
+                 "\"node_frees\":%zu,\"bytes_allocated\":%zu,\"searches\":%zu,\"traversal_steps\":%zu,"
+                 "\"peak_size\":%zu}\n",
+            stats_enabled() ? "true" : "false", list->size, list->pool != NULL ? "true" : "false",
+            s.node_allocations, s.node_frees, s.bytes_allocated, s.searches, s.traversal_steps, s.peak_size);
+}
+
+void pool_stats_dump_json(FILE *out, const char *name, const MemPool *pool) {
+    if (out == NULL || pool == NULL) {
+        return;
+    }
+    PoolStats s;
+    pool_get_stats(pool, &s);
+    fprintf(out, "{\"type\":\"mempool\",\"name\":");
+    write_json_string(out, name);
+    fprintf(out, ",\"stats_enabled\":%s,\"block_size\":%zu,\"num_blocks\":%zu,\"total_size\":%zu,"
+                 "\"allocations\":%zu,\"deallocations\":%zu,\"in_use\":%zu,\"peak_in_use\":%zu,"
+                 "\"slabs_added\":%zu,\"slabs_released\":%zu,\"exhaustion_events\":%zu}\n",
+            stats_enabled() ? "true" : "false", pool->block_size, pool->num_blocks, pool->total_size,
+            s.allocations, s.deallocations, s.in_use, s.peak_in_use,
+            s.slabs_added, s.slabs_released, s.exhaustion_events);
+}
@@ -0,0 +1,27 @@
+#ifndef STATS_INTERNAL_H
+#define STATS_INTERNAL_H
+
+#include <string.h> // For memset in STATS_RESET
+
+// Library-private counter macros. Without MY_C_LIB_STATS the containers have
+// no 'stats' member and these expand to nothing.
+#ifdef MY_C_LIB_STATS
+#define STATS_INC(obj, field) ((obj)->stats.field++)
+#define STATS_DEC(obj, field) ((obj)->stats.field--)
+#define STATS_ADD(obj, field, n) ((obj)->stats.field += (n))
+#define STATS_SUB(obj, field, n) ((obj)->stats.field -= (n))
+#define STATS_SET(obj, field, v) ((obj)->stats.field = (v))
+#define STATS_MAX(obj, field, v) \
+    do { if ((v) > (obj)->stats.field) (obj)->stats.field = (v); } while (0)
+#define STATS_RESET(obj) memset(&(obj)->stats, 0, sizeof((obj)->stats))
+#else
+#define STATS_INC(obj, field) ((void)0)
+#define STATS_DEC(obj, field) ((void)0)
+#define STATS_ADD(obj, field, n) ((void)0)
+#define STATS_SUB(obj, field, n) ((void)0)
+#define STATS_SET(obj, field, v) ((void)0)
+#define STATS_MAX(obj, field, v) ((void)0)
+#define STATS_RESET(obj) ((void)0)
+#endif
+
+#endif // STATS_INTERNAL_H
@@ -0,0 +1,178 @@
+#define _POSIX_C_SOURCE 200809L // For sysconf(_SC_NPROCESSORS_ONLN)
+#include "thread_pool.h"
+#include "diag_internal.h" // For DIAG_* logging macros
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h> // For sysconf
+
+// One call to thread_pool_run(). It lives on the caller's stack; the caller
+// unpublishes it and waits for 'active' to drop to zero before returning, so
+// no worker can touch it afterwards.
+typedef struct ThreadPoolJob {
+    ThreadPoolTaskFn fn;
+    void *arg;
+    size_t tasks;
+    _Atomic size_t next_task; // Next unclaimed task index
+    size_t active;            // Workers inside the job, guarded by pool->lock
+} ThreadPoolJob;
+
+// Set while this thread runs tasks of a job that other threads share. A task
+// that calls thread_pool_run() again would wait on 'run_lock', which its own
+// job holds, so nested jobs run inline instead.
+static _Thread_local int inside_pool_job = 0;
+
+// Claims and runs task indices until none are left.
+static void run_tasks(ThreadPoolJob *job) {
+    for (;;) {
+        size_t task = atomic_fetch_add_explicit(&job->next_task, 1, memory_order_relaxed);
+        if (task >= job->tasks) {
+            return;
+        }
+        job->fn(job->arg, task);
+    }
+}
+
+static void* worker_main(void *arg) {
+    ThreadPool *pool = (ThreadPool *)arg;
+    unsigned long seen = 0;
+    inside_pool_job = 1; // A worker only ever runs tasks of shared jobs
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->shutting_down && (pool->job == NULL || pool->generation == seen)) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if (pool->shutting_down) {
+            break;
+        }
+        seen = pool->generation;
+        ThreadPoolJob *job = pool->job;
+        job->active++;
+        pthread_mutex_unlock(&pool->lock);
+
+        run_tasks(job);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--job->active == 0) {
+            pthread_cond_broadcast(&pool->work_done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+static size_t online_cpus(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (size_t)cpus : 1;
+}
+
+ThreadPool* thread_pool_create(size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = online_cpus() - 1; // The caller of thread_pool_run() is the last worker
+    }
+    ThreadPool *pool = (ThreadPool *)malloc(sizeof(ThreadPool));
+    if (pool == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate memory for ThreadPool.");
+        return NULL;
+    }
+    pool->threads = NULL;
+    if (num_threads > 0) {
+        pool->threads = (pthread_t *)malloc(num_threads * sizeof(pthread_t));
+        if (pool->threads == NULL) {
+            DIAG_ERROR_MSG("Failed to allocate memory for %zu thread handles.", num_threads);
+            free(pool);
+            return NULL;
+        }
+    }
+    pool->num_threads = 0;
+    pool->job = NULL;
+    pool->generation = 0;
+    pool->shutting_down = 0;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+    pthread_mutex_init(&pool->run_lock, NULL);
+    for (size_t i = 0; i < num_threads; ++i) {
+        if (pthread_create(&pool->threads[i], NULL, worker_main, pool) != 0) {
+            DIAG_ERROR_MSG("Failed to start worker %zu.", i);
+            thread_pool_destroy(pool); // Joins the workers started so far
+            return NULL;
+        }
+        pool->num_threads++;
+    }
+    DIAG_TRACE_MSG("Thread pool started with %zu workers.", pool->num_threads);
+    return pool;
+}
+
+int thread_pool_run(ThreadPool *pool, ThreadPoolTaskFn fn, void *arg, size_t tasks) {
+    if (fn == NULL) {
+        DIAG_ERROR_MSG("Task function is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    ThreadPoolJob job;
+    job.fn = fn;
+    job.arg = arg;
+    job.tasks = tasks;
+    atomic_init(&job.next_task, 0);
+    job.active = 0;
+    if (pool == NULL || pool->num_threads == 0 || tasks <= 1 || inside_pool_job) {
+        run_tasks(&job); // Nothing to share, or called from a task: stay on this thread
+        return LIB_OK;
+    }
+
+    pthread_mutex_lock(&pool->run_lock);
+    pthread_mutex_lock(&pool->lock);
+    pool->job = &job;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    inside_pool_job = 1;
+    run_tasks(&job);
+    inside_pool_job = 0;
+
+    // Every task is claimed now. Stop late workers from joining, then wait
+    // for the ones inside to finish the tasks they hold.
+    pthread_mutex_lock(&pool->lock);
+    pool->job = NULL;
+    while (job.active > 0) {
+        pthread_cond_wait(&pool->work_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&pool->run_lock);
+    return LIB_OK;
+}
+
+size_t thread_pool_concurrency(const ThreadPool *pool) {
+    return pool != NULL ? pool->num_threads + 1 : 1;
+}
+
+static ThreadPool *default_pool = NULL;
+static pthread_once_t default_pool_once = PTHREAD_ONCE_INIT;
+
+static void create_default_pool(void) {
+    default_pool = thread_pool_create(0);
+}
+
+ThreadPool* thread_pool_default(void) {
+    pthread_once(&default_pool_once, create_default_pool);
+    return default_pool;
+}
+
+void thread_pool_destroy(ThreadPool *pool) {
+    if (pool == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->shutting_down = 1;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+    for (size_t i = 0; i < pool->num_threads; ++i) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_cond_destroy(&pool->work_done);
+    pthread_mutex_destroy(&pool->run_lock);
+    free(pool->threads);
+    free(pool);
+}
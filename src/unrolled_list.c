@@ -0,0 +1,297 @@
+#include "unrolled_list.h"
+#include "diag_internal.h" // For DIAG_* logging macros
+#include <stdio.h>  // For printf in printUList
+#include <stdlib.h> // For aligned_alloc
+#include <string.h> // For memmove, memcpy
+
+_Static_assert(sizeof(UNode) == 64, "UNode is meant to fill exactly one cache line when 64-byte aligned");
+
+#define UNODE_CAPACITY ((int)ULIST_NODE_VALUES)
+// A node that drops below this many values after a delete is merged with its
+// successor when both fit in one node, keeping nodes at least about half full.
+#define UNODE_MERGE_THRESHOLD (UNODE_CAPACITY / 2)
+
+// Helper function to allocate an empty, detached node. malloc only promises
+// 16-byte alignment, so on the default allocator nodes come from aligned_alloc
+// instead and each one sits on a single cache line; its free() releases them.
+static UNode* createUNode(UnrolledList *list) {
+    UNode *node = list->allocator == allocator_default()
+                      ? (UNode *)aligned_alloc(64, sizeof(UNode))
+                      : (UNode *)list->allocator->alloc(list->allocator->ctx, sizeof(UNode));
+    if (node == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate memory for new unrolled node.");
+        return NULL;
+    }
+    node->next = NULL;
+    node->count = 0;
+    list->node_count++;
+    return node;
+}
+
+// Helper function to link a detached node after 'prev' (or at the head when prev is NULL)
+static void linkUNodeAfter(UnrolledList *list, UNode *prev, UNode *node) {
+    if (prev == NULL) {
+        node->next = list->head;
+        list->head = node;
+    } else {
+        node->next = prev->next;
+        prev->next = node;
+    }
+    if (node->next == NULL) {
+        list->tail = node;
+    }
+}
+
+// Helper function to unlink and free 'node', whose predecessor is 'prev' (NULL for the head)
+static void removeUNode(UnrolledList *list, UNode *prev, UNode *node) {
+    if (prev == NULL) {
+        list->head = node->next;
+    } else {
+        prev->next = node->next;
+    }
+    if (list->tail == node) {
+        list->tail = prev;
+    }
+    list->allocator->free(list->allocator->ctx, node, sizeof(UNode));
+    list->node_count--;
+}
+
+// Helper function to insert 'data' at slot 'index' of 'node'. A full node is
+// split first, moving its upper half into a new node linked right after it.
+static int insertIntoUNode(UnrolledList *list, UNode *node, int index, int data) {
+    if (node->count == UNODE_CAPACITY) {
+        UNode *upper = createUNode(list);
+        if (upper == NULL) {
+            return LIB_ERR_NO_MEMORY;
+        }
+        int keep = UNODE_CAPACITY / 2;
+        upper->count = node->count - keep;
+        memcpy(upper->values, node->values + keep, (size_t)upper->count * sizeof(int));
+        node->count = keep;
+        linkUNodeAfter(list, node, upper);
+        if (index > keep) {
+            node = upper;
+            index -= keep;
+        }
+    }
+    memmove(node->values + index + 1, node->values + index, (size_t)(node->count - index) * sizeof(int));
+    node->values[index] = data;
+    node->count++;
+    list->size++;
+    return LIB_OK;
+}
+
+// Helper function to remove slot 'index' of 'node' (predecessor 'prev'), then
+// free the node if it emptied or merge it with its successor if it is sparse.
+static void eraseFromUNode(UnrolledList *list, UNode *prev, UNode *node, int index) {
+    memmove(node->values + index, node->values + index + 1, (size_t)(node->count - index - 1) * sizeof(int));
+    node->count--;
+    list->size--;
+    if (node->count == 0) {
+        removeUNode(list, prev, node);
+        return;
+    }
+    UNode *next = node->next;
+    if (node->count < UNODE_MERGE_THRESHOLD && next != NULL && node->count + next->count <= UNODE_CAPACITY) {
+        memcpy(node->values + node->count, next->values, (size_t)next->count * sizeof(int));
+        node->count += next->count;
+        removeUNode(list, node, next);
+    }
+}
+
+// Helper function to locate the first occurrence of 'data'. On success fills
+// in the node, its predecessor and the slot index, and returns 1.
+static int findInUList(UnrolledList *list, int data, UNode **prev_out, UNode **node_out, int *index_out) {
+    UNode *prev = NULL;
+    for (UNode *node = list->head; node != NULL; prev = node, node = node->next) {
+        for (int i = 0; i < node->count; ++i) {
+            if (node->values[i] == data) {
+                *prev_out = prev;
+                *node_out = node;
+                *index_out = i;
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+UnrolledList* createUList(void) {
+    return createUListWithAllocator(allocator_default());
+}
+
+UnrolledList* createUListWithAllocator(const Allocator *allocator) {
+    if (allocator == NULL) {
+        DIAG_ERROR_MSG("Allocator is NULL.");
+        return NULL;
+    }
+    UnrolledList *list = (UnrolledList *)allocator->alloc(allocator->ctx, sizeof(UnrolledList));
+    if (list == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate memory for UnrolledList.");
+        return NULL;
+    }
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    list->node_count = 0;
+    list->allocator = allocator;
+    return list;
+}
+
+int ulistIsEmpty(UnrolledList *list) {
+    return list == NULL || list->size == 0;
+}
+
+int ulistInsertAtBeginning(UnrolledList *list, int data) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("List is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (list->head == NULL || list->head->count == UNODE_CAPACITY) {
+        // Start a fresh head node rather than splitting a full one
+        UNode *node = createUNode(list);
+        if (node == NULL) {
+            return LIB_ERR_NO_MEMORY;
+        }
+        linkUNodeAfter(list, NULL, node);
+    }
+    return insertIntoUNode(list, list->head, 0, data);
+}
+
+int ulistInsertAtEnd(UnrolledList *list, int data) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("List is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (list->tail == NULL || list->tail->count == UNODE_CAPACITY) {
+        // Appends fill each tail node completely before starting the next
+        UNode *node = createUNode(list);
+        if (node == NULL) {
+            return LIB_ERR_NO_MEMORY;
+        }
+        linkUNodeAfter(list, list->tail, node);
+    }
+    UNode *tail = list->tail;
+    tail->values[tail->count++] = data;
+    list->size++;
+    return LIB_OK;
+}
+
+int ulistInsertAfter(UnrolledList *list, int data, int after_value) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("List is NULL.");
+        return 0;
+    }
+    UNode *prev;
+    UNode *node;
+    int index;
+    if (!findInUList(list, after_value, &prev, &node, &index)) {
+        DIAG_ERROR_MSG("Value %d not found in the list.", after_value);
+        return 0;
+    }
+    return insertIntoUNode(list, node, index + 1, data) == LIB_OK;
+}
+
+int ulistDeleteValue(UnrolledList *list, int data) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("List is NULL.");
+        return 0;
+    }
+    UNode *prev;
+    UNode *node;
+    int index;
+    if (!findInUList(list, data, &prev, &node, &index)) {
+        DIAG_ERROR_MSG("Value %d not found in the list.", data);
+        return 0;
+    }
+    eraseFromUNode(list, prev, node, index);
+    return 1;
+}
+
+int ulistDeleteAtPosition(UnrolledList *list, int position) {
+    if (list == NULL || position < 0 || (size_t)position >= list->size) {
+        DIAG_ERROR_MSG("Invalid list or position %d out of bounds.", position);
+        return -1;
+    }
+    UNode *prev = NULL;
+    UNode *node = list->head;
+    while (position >= node->count) { // Skip whole nodes
+        position -= node->count;
+        prev = node;
+        node = node->next;
+    }
+    int data = node->values[position];
+    eraseFromUNode(list, prev, node, position);
+    return data;
+}
+
+int ulistGet(UnrolledList *list, size_t position, int *out) {
+    if (list == NULL || out == NULL) {
+        DIAG_ERROR_MSG("List or output pointer is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (position >= list->size) {
+        DIAG_ERROR_MSG("Position %zu out of bounds (size %zu).", position, list->size);
+        return LIB_ERR_OUT_OF_RANGE;
+    }
+    UNode *node = list->head;
+    while (position >= (size_t)node->count) {
+        position -= (size_t)node->count;
+        node = node->next;
+    }
+    *out = node->values[position];
+    return LIB_OK;
+}
+
+int* ulistSearch(UnrolledList *list, int data) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("List is NULL.");
+        return NULL;
+    }
+    UNode *prev;
+    UNode *node;
+    int index;
+    if (!findInUList(list, data, &prev, &node, &index)) {
+        return NULL; // Data not found
+    }
+    return &node->values[index];
+}
+
+void printUList(UnrolledList *list) {
+    if (list == NULL) {
+        printf("List is NULL.\n");
+        return;
+    }
+    if (list->head == NULL) {
+        printf("List is empty.\n");
+        return;
+    }
+    printf("List elements (%zu in %zu nodes): ", list->size, list->node_count);
+    for (UNode *node = list->head; node != NULL; node = node->next) {
+        for (int i = 0; i < node->count; ++i) {
+            printf("%d -> ", node->values[i]);
+        }
+    }
+    printf("NULL\n");
+}
+
+size_t getUListSize(UnrolledList *list) {
+    if (list == NULL) {
+        DIAG_ERROR_MSG("List is NULL.");
+        return 0;
+    }
+    return list->size;
+}
+
+void destroyUList(UnrolledList *list) {
+    if (list == NULL) {
+        return; // Nothing to destroy
+    }
+    UNode *current = list->head;
+    while (current != NULL) {
+        UNode *next_node = current->next; // Store next node before freeing current
+        list->allocator->free(list->allocator->ctx, current, sizeof(UNode));
+        current = next_node;
+    }
+    list->allocator->free(list->allocator->ctx, list, sizeof(UnrolledList)); // Free the UnrolledList structure itself
+}
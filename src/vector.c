@@ -1,139 +1,344 @@
 #include "vector.h" // Include your library's header
-#include <stdio.h>  // For perror, fprintf
-#include <stdlib.h> // For malloc, realloc, free
-#include <string.h> // For memcpy
+#include "diag_internal.h" // For DIAG_ERROR_MSG
+#include "stats_internal.h" // For STATS_* counters
+#include "vector_mapped_internal.h" // For file-backed storage
+#include <stdint.h> // For SIZE_MAX
+#include <string.h> // For memcpy, memmove, memset
 
 
+// Returns the address of the slot at 'index' inside the contiguous buffer.
+static inline char* vector_slot(const Vector* vec, size_t index) {
+    return vec->data + index * vec->element_size;
+}
+
 // Private helper function (static means it's only visible within this file)
-static int vector_resize(Vector* vec, size_t new_capacity) {
-    if (new_capacity < vec->size) { // Should not happen with typical doubling strategy
-        fprintf(stderr, "Warning: Resizing to a capacity smaller than current size.\n");
+static int vector_set_capacity(Vector* vec, size_t new_capacity) {
+    if (new_capacity < vec->size) { // Callers never shrink below the live elements
+        DIAG_ERROR_MSG("Resizing to a capacity smaller than current size.");
+    }
+    if (new_capacity > SIZE_MAX / vec->element_size) {
+        DIAG_ERROR_MSG("Requested capacity overflows size_t.");
+        return LIB_ERR_NO_MEMORY;
+    }
+    if (vec->mapping != NULL) {
+        // A mapped vector grows its file instead of asking the allocator
+        int status = vector_mapping_resize(vec, new_capacity);
+        if (status == LIB_OK) {
+            STATS_INC(vec, resizes);
+            STATS_SET(vec, current_bytes, new_capacity * vec->element_size);
+            STATS_MAX(vec, peak_bytes, new_capacity * vec->element_size);
+        }
+        return status;
     }
-    void** new_data = (void**)realloc(vec->data, new_capacity * sizeof(void*));
+    char* new_data = (char*)vec->allocator->realloc(vec->allocator->ctx, vec->data,
+                                                    vec->capacity * vec->element_size,
+                                                    new_capacity * vec->element_size);
     if (new_data == NULL) {
-        perror("vector_resize: Failed to reallocate vector data");
-        return -1; // Indicate failure
+        DIAG_ERROR_MSG("Failed to reallocate vector data.");
+        return LIB_ERR_NO_MEMORY;
     }
     vec->data = new_data;
     vec->capacity = new_capacity;
-    return 0; // Indicate success
+    STATS_INC(vec, allocations);
+    STATS_INC(vec, resizes);
+    STATS_ADD(vec, bytes_allocated, new_capacity * vec->element_size);
+    STATS_SET(vec, current_bytes, new_capacity * vec->element_size);
+    STATS_MAX(vec, peak_bytes, new_capacity * vec->element_size);
+    return LIB_OK;
+}
+
+// Makes room for at least 'min_capacity' elements, doubling so that a run of
+// single appends stays amortized O(1).
+static int vector_grow(Vector* vec, size_t min_capacity) {
+    if (min_capacity <= vec->capacity) {
+        return LIB_OK; // Already large enough
+    }
+    size_t new_capacity = vec->capacity * 2;
+    if (new_capacity < min_capacity) {
+        new_capacity = min_capacity;
+    }
+    return vector_set_capacity(vec, new_capacity);
 }
 
 Vector* vector_create(size_t initial_capacity, size_t element_size){
-    if(initial_capacity==0 || element_size==0){
-         fprintf(stderr, "vector::vector_create: Initial capacity and element size must be greater than 0.\n");
+    return vector_create_with_allocator(initial_capacity, element_size, allocator_default());
+}
+
+Vector* vector_create_with_allocator(size_t initial_capacity, size_t element_size, const Allocator* allocator){
+    if(initial_capacity==0 || element_size==0 || allocator==NULL){
+        DIAG_ERROR_MSG("Initial capacity and element size must be greater than 0, and allocator non-NULL.");
+        return NULL;
+    }
+    if(initial_capacity > SIZE_MAX / element_size){
+        DIAG_ERROR_MSG("Initial capacity overflows size_t.");
         return NULL;
     }
-    Vector* vec = (Vector*)malloc(sizeof(Vector));
+    Vector* vec = (Vector*)allocator->alloc(allocator->ctx, sizeof(Vector));
     if(vec == NULL){
-        perror("vector::vector_create: Failed to allocate memory for Vector structure.");
+        DIAG_ERROR_MSG("Failed to allocate memory for Vector structure.");
         return NULL;
     }
-    vec->data = (void**)malloc(initial_capacity * sizeof(void*));
+    // One buffer holds every element back to back: capacity * element_size bytes.
+    vec->data = (char*)allocator->alloc(allocator->ctx, initial_capacity * element_size);
     if(vec->data == NULL){
-        perror("vector::vector_create: Failed to allocate memory for Vector data array.");
-        free(vec);
+        DIAG_ERROR_MSG("Failed to allocate memory for Vector data array.");
+        allocator->free(allocator->ctx, vec, sizeof(Vector));
         return NULL;
     }
     vec->size = 0;
     vec->capacity = initial_capacity;
     vec->element_size = element_size;
+    vec->allocator = allocator;
+    vec->mapping = NULL;
+    STATS_RESET(vec);
+    STATS_INC(vec, allocations);
+    STATS_ADD(vec, bytes_allocated, initial_capacity * element_size);
+    STATS_SET(vec, current_bytes, initial_capacity * element_size);
+    STATS_SET(vec, peak_bytes, initial_capacity * element_size);
     return vec;
 }
 
 int vector_add(Vector* vec, const void* element){
     if (vec == NULL || element == NULL) {
-        fprintf(stderr, "vector::vector_add: Vector or element is NULL.\n");
-        return -1; // Indicate failure
+        DIAG_ERROR_MSG("Vector or element is NULL.");
+        return LIB_ERR_INVALID_ARG;
     }
+    const char* from = (const char*)element;
     if (vec->size >= vec->capacity) {
+        char* old_data = vec->data;
+        int aliases = from >= old_data && from < old_data + vec->size * vec->element_size;
+        size_t src_offset = aliases ? (size_t)(from - old_data) : 0;
         // Double the capacity if we are out of space
-        size_t new_capacity = vec->capacity * 2;
-        if (vector_resize(vec, new_capacity) != 0) {
-            return -1; // Indicate failure
+        int status = vector_grow(vec, vec->size + 1);
+        if (status != LIB_OK) {
+            return status;
+        }
+        if (aliases) {
+            // 'element' points into this vector: locate it again after the grow
+            from = (const char*)vec->data + src_offset;
         }
     }
-    // Allocate memory for the new element
-    void* new_element = malloc(vec->element_size);
-    if (new_element == NULL) {
-        perror("vector::vector_add: Failed to allocate memory for new element.");
-        return -1; // Indicate failure
-    }
-    // Copy the element data into the new element
-    memcpy(new_element, element, vec->element_size);
-    // Add the new element to the vector
-    vec->data[vec->size] = new_element;
+    // Copy the element data straight into its slot
+    memcpy(vector_slot(vec, vec->size), from, vec->element_size);
     vec->size++;
-    return 0; // Indicate success
-    
+    STATS_MAX(vec, peak_size, vec->size);
+    return LIB_OK;
 }
 
 void* vector_get(const Vector* vec, int index){
-    if (vec == NULL || index < 0 || index >= vec->size) {
-        fprintf(stderr, "vector::vector_get: Invalid vector or index out of bounds.\n");
+    if (vec == NULL || index < 0 || (size_t)index >= vec->size) {
+        DIAG_ERROR_MSG("Invalid vector or index %d out of bounds.", index);
         return NULL; // Indicate failure
     }
-    return vec->data[index]; // Return the element at the specified index
+    return vector_slot(vec, (size_t)index); // Address of the element inside the buffer
 }
 int vector_set(Vector* vec, int index, const void* element){
-    if (vec == NULL || element == NULL || index < 0 || index >= vec->size) {
-        fprintf(stderr, "vector::vector_set: Invalid vector, element, or index out of bounds.\n");
-        return -1; // Indicate failure
-    }
-    // Allocate memory for the new element
-    void* new_element = malloc(vec->element_size);
-    if (new_element == NULL) {
-        perror("vector::vector_set: Failed to allocate memory for new element.");
-        return -1; // Indicate failure
-    }
-    // Copy the element data into the new element
-    memcpy(new_element, element, vec->element_size);
-    // Free the old element and replace it with the new one
-    free(vec->data[index]);
-    vec->data[index] = NULL; // Set to NULL to avoid dangling pointer
-    // Assign the new element to the vector at the specified index
-    vec->data[index] = new_element;
-    return 0; // Indicate success
+    if (vec == NULL || element == NULL) {
+        DIAG_ERROR_MSG("Vector or element is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (index < 0 || (size_t)index >= vec->size) {
+        DIAG_ERROR_MSG("Index %d out of bounds (size %zu).", index, vec->size);
+        return LIB_ERR_OUT_OF_RANGE;
+    }
+    // Overwrite the slot in place; memmove tolerates 'element' pointing into the vector
+    memmove(vector_slot(vec, (size_t)index), element, vec->element_size);
+    return LIB_OK;
 }
 
 int vector_remove(Vector* vec, int index) {
-    if (vec == NULL || index < 0 || index >= vec->size) {
-        fprintf(stderr, "vector::vector_remove: Invalid vector or index out of bounds.\n");
-        return -1; // Indicate failure
-    }
-    // Free the memory for the element being removed
-    free(vec->data[index]);
-    vec->data[index] = NULL; // Set to NULL to avoid dangling pointer
-    // Shift elements to fill the gap
-    for (size_t i = index; i < vec->size - 1; i++) {
-        vec->data[i] = vec->data[i + 1];
-    }
-    vec->data[vec->size - 1] = NULL; // Clear the last element
+    if (vec == NULL) {
+        DIAG_ERROR_MSG("Invalid vector.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (index < 0 || (size_t)index >= vec->size) {
+        DIAG_ERROR_MSG("Index %d out of bounds (size %zu).", index, vec->size);
+        return LIB_ERR_OUT_OF_RANGE;
+    }
+    // Shift the tail down one slot to fill the gap
+    size_t tail = vec->size - (size_t)index - 1;
+    memmove(vector_slot(vec, (size_t)index), vector_slot(vec, (size_t)index + 1),
+            tail * vec->element_size);
     vec->size--; // Decrease the size of the vector
-    return 0; // Indicate success
+    return LIB_OK;
+}
+int vector_swap_remove(Vector* vec, int index) {
+    if (vec == NULL) {
+        DIAG_ERROR_MSG("Invalid vector.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (index < 0 || (size_t)index >= vec->size) {
+        DIAG_ERROR_MSG("Index %d out of bounds (size %zu).", index, vec->size);
+        return LIB_ERR_OUT_OF_RANGE;
+    }
+    // Move the last element into the hole instead of shifting the tail
+    size_t last = vec->size - 1;
+    if ((size_t)index != last) {
+        memcpy(vector_slot(vec, (size_t)index), vector_slot(vec, last), vec->element_size);
+    }
+    vec->size--;
+    return LIB_OK;
+}
+
+int vector_erase_range(Vector* vec, size_t first, size_t last) {
+    if (vec == NULL) {
+        DIAG_ERROR_MSG("Invalid vector.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (first > last || last > vec->size) {
+        DIAG_ERROR_MSG("Range [%zu, %zu) out of bounds (size %zu).", first, last, vec->size);
+        return LIB_ERR_OUT_OF_RANGE;
+    }
+    // Close the gap [first, last) with a single move of the tail
+    size_t tail = vec->size - last;
+    memmove(vector_slot(vec, first), vector_slot(vec, last), tail * vec->element_size);
+    vec->size -= last - first;
+    return LIB_OK;
+}
+
+int vector_insert_n(Vector* vec, size_t index, const void* src, size_t count) {
+    if (vec == NULL || (src == NULL && count > 0)) {
+        DIAG_ERROR_MSG("Vector or source array is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (index > vec->size) {
+        DIAG_ERROR_MSG("Index %zu out of bounds (size %zu).", index, vec->size);
+        return LIB_ERR_OUT_OF_RANGE;
+    }
+    if (count > SIZE_MAX - vec->size) {
+        DIAG_ERROR_MSG("Element count overflows size_t.");
+        return LIB_ERR_NO_MEMORY;
+    }
+    if (count == 0) {
+        return LIB_OK; // Nothing to insert
+    }
+    const char* from = (const char*)src;
+    char* old_data = vec->data;
+    int aliases = from >= old_data && from < old_data + vec->size * vec->element_size;
+    size_t src_offset = aliases ? (size_t)(from - old_data) : 0;
+    int status = vector_grow(vec, vec->size + count);
+    if (status != LIB_OK) {
+        return status;
+    }
+    // Open a gap of 'count' slots at 'index', then copy the new elements in
+    memmove(vector_slot(vec, index + count), vector_slot(vec, index),
+            (vec->size - index) * vec->element_size);
+    if (aliases) {
+        // 'src' points into this vector: locate it again after the grow and the shift
+        size_t gap_start = index * vec->element_size;
+        size_t gap_bytes = count * vec->element_size;
+        size_t src_bytes = count * vec->element_size;
+        char* base = vec->data;
+        char* dst = base + gap_start;
+        if (src_offset + src_bytes <= gap_start) {
+            memcpy(dst, base + src_offset, src_bytes);              // entirely before the gap
+        } else if (src_offset >= gap_start) {
+            memcpy(dst, base + src_offset + gap_bytes, src_bytes);  // entirely after, shifted up
+        } else {
+            size_t head = gap_start - src_offset;                   // straddles the gap
+            memmove(dst, base + src_offset, head);
+            memcpy(dst + head, base + gap_start + gap_bytes, src_bytes - head);
+        }
+    } else {
+        memcpy(vector_slot(vec, index), src, count * vec->element_size);
+    }
+    vec->size += count;
+    STATS_MAX(vec, peak_size, vec->size);
+    return LIB_OK;
+}
+
+int vector_append_n(Vector* vec, const void* src, size_t count) {
+    if (vec == NULL || (src == NULL && count > 0)) {
+        DIAG_ERROR_MSG("Vector or source array is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (count > SIZE_MAX - vec->size) {
+        DIAG_ERROR_MSG("Element count overflows size_t.");
+        return LIB_ERR_NO_MEMORY;
+    }
+    const char* from = (const char*)src;
+    char* old_data = vec->data;
+    int aliases = from >= old_data && from < old_data + vec->size * vec->element_size;
+    size_t src_offset = aliases ? (size_t)(from - old_data) : 0;
+    // One capacity check and one copy for the whole batch
+    int status = vector_grow(vec, vec->size + count);
+    if (status != LIB_OK) {
+        return status;
+    }
+    if (aliases) {
+        // 'src' points into this vector: locate it again after the grow
+        from = (const char*)vec->data + src_offset;
+    }
+    memcpy(vector_slot(vec, vec->size), from, count * vec->element_size);
+    vec->size += count;
+    STATS_MAX(vec, peak_size, vec->size);
+    return LIB_OK;
+}
+
+int vector_reserve(Vector* vec, size_t capacity) {
+    if (vec == NULL) {
+        DIAG_ERROR_MSG("Invalid vector.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (capacity <= vec->capacity) {
+        return LIB_OK; // Never shrinks; use vector_shrink_to_fit for that
+    }
+    return vector_set_capacity(vec, capacity);
+}
+
+int vector_resize(Vector* vec, size_t new_size) {
+    if (vec == NULL) {
+        DIAG_ERROR_MSG("Invalid vector.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (new_size > vec->size) {
+        int status = vector_grow(vec, new_size);
+        if (status != LIB_OK) {
+            return status;
+        }
+        // Newly exposed elements start zeroed
+        memset(vector_slot(vec, vec->size), 0, (new_size - vec->size) * vec->element_size);
+    }
+    vec->size = new_size;
+    STATS_MAX(vec, peak_size, vec->size);
+    return LIB_OK;
+}
+
+int vector_shrink_to_fit(Vector* vec) {
+    if (vec == NULL) {
+        DIAG_ERROR_MSG("Invalid vector.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    // Keep at least one slot so the buffer is never a zero-sized allocation
+    size_t new_capacity = vec->size > 0 ? vec->size : 1;
+    if (new_capacity == vec->capacity) {
+        return LIB_OK; // Nothing to release
+    }
+    return vector_set_capacity(vec, new_capacity);
 }
+
 size_t vector_size(const Vector* vec) {
     if (vec == NULL) {
-        fprintf(stderr, "vector::vector_size: Invalid vector.\n");
+        DIAG_ERROR_MSG("Invalid vector.");
         return 0; // Indicate failure
     }
     return vec->size; // Return the current size of the vector
 }
 void vector_destroy(Vector* vec){
     if (vec == NULL) {
-        fprintf(stderr, "vector::vector_destroy: Invalid vector.\n");
+        DIAG_ERROR_MSG("Invalid vector.");
         return; // Nothing to destroy
     }
-    // Free each element in the vector
-    for (size_t i = 0; i < vec->size; i++) {
-        free(vec->data[i]);
-        vec->data[i] = NULL; // Set to NULL to avoid dangling pointers
+    // Elements live inside the data buffer, so a single free releases them all
+    const Allocator* allocator = vec->allocator;
+    if (vec->mapping != NULL) {
+        vector_mapping_close(vec); // Unmaps the file; its contents stay on disk
+    } else {
+        allocator->free(allocator->ctx, vec->data, vec->capacity * vec->element_size);
     }
-    // Free the data array and the vector structure itself
-    free(vec->data);
     vec->data = NULL; // Set to NULL to avoid dangling pointer
-    vec->size = 0; // Reset size    
-    free(vec);
+    vec->size = 0; // Reset size
+    allocator->free(allocator->ctx, vec, sizeof(Vector));
     vec = NULL; // Set to NULL to avoid dangling pointer
-    fprintf(stderr, "vector::vector_destroy: Vector destroyed successfully.\n");
-}
\ No newline at end of file
+    DIAG_TRACE_MSG("Vector destroyed successfully.");
+}
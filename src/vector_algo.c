@@ -0,0 +1,409 @@
+#include "vector_algo.h"
+#include "thread_pool.h"   // For thread_pool_default, thread_pool_run
+#include "diag_internal.h" // For DIAG_ERROR_MSG
+#include <stdint.h> // For uint32_t, uint64_t
+#include <stdlib.h> // For malloc, free
+#include <string.h> // For memcpy, memmove
+
+// Below these sizes the thread hand-off costs more than it saves.
+#define SORT_SERIAL_THRESHOLD 16384
+#define RADIX_SERIAL_THRESHOLD 65536
+#define PARALLEL_FOR_MIN_CHUNK 4096       // elements per vector_parallel_for chunk, at least
+#define PARALLEL_FOR_CHUNKS_PER_THREAD 4  // extra chunks let fast threads pick up slack
+#define MERGE_TASKS_PER_THREAD 2
+#define COPY_MIN_CHUNK_BYTES ((size_t)1 << 20)
+// Runs this short are sorted by insertion before the merge passes start.
+#define INSERTION_RUN 32
+#define RADIX_BUCKETS 256
+
+typedef int (*CompareFn)(const void*, const void*);
+
+// Start of part 'part' when 'n' items are split into 'parts' near-equal parts.
+// Computed without forming n * part, which could overflow.
+static inline size_t split_point(size_t n, size_t part, size_t parts) {
+    return n / parts * part + n % parts * part / parts;
+}
+
+// Element copy with fixed-size fast paths for the common record sizes.
+static inline void copy_element(char* dst, const char* src, size_t element_size) {
+    switch (element_size) {
+        case 4:  memcpy(dst, src, 4); break;
+        case 8:  memcpy(dst, src, 8); break;
+        case 16: memcpy(dst, src, 16); break;
+        default: memcpy(dst, src, element_size); break;
+    }
+}
+
+// --- Parallel copy ---
+
+typedef struct CopyJob {
+    char* dst;
+    const char* src;
+    size_t bytes;
+    size_t chunks;
+} CopyJob;
+
+static void copy_task(void* arg, size_t chunk) {
+    CopyJob* job = (CopyJob*)arg;
+    size_t begin = split_point(job->bytes, chunk, job->chunks);
+    size_t end = split_point(job->bytes, chunk + 1, job->chunks);
+    memcpy(job->dst + begin, job->src + begin, end - begin);
+}
+
+static void parallel_copy(ThreadPool* pool, char* dst, const char* src, size_t bytes) {
+    size_t chunks = thread_pool_concurrency(pool);
+    if (bytes / COPY_MIN_CHUNK_BYTES < chunks) {
+        chunks = bytes / COPY_MIN_CHUNK_BYTES > 0 ? bytes / COPY_MIN_CHUNK_BYTES : 1;
+    }
+    CopyJob job = { dst, src, bytes, chunks };
+    thread_pool_run(pool, copy_task, &job, chunks);
+}
+
+// --- Merge sort ---
+
+// Stable merge of a[0, na) and b[0, nb) into 'out': on ties the element from 'a' goes first.
+static void merge_runs(const char* a, size_t na, const char* b, size_t nb, char* out,
+                       size_t element_size, CompareFn compare) {
+    while (na > 0 && nb > 0) {
+        if (compare(b, a) < 0) {
+            copy_element(out, b, element_size);
+            b += element_size;
+            nb--;
+        } else {
+            copy_element(out, a, element_size);
+            a += element_size;
+            na--;
+        }
+        out += element_size;
+    }
+    memcpy(out, a, na * element_size);
+    memcpy(out + na * element_size, b, nb * element_size);
+}
+
+// Stable in-place insertion sort of a short run; 'scratch' holds one element.
+static void insertion_sort(char* base, size_t n, size_t element_size, CompareFn compare, char* scratch) {
+    for (size_t i = 1; i < n; ++i) {
+        char* current = base + i * element_size;
+        if (compare(current - element_size, current) <= 0) {
+            continue; // Already in place
+        }
+        copy_element(scratch, current, element_size);
+        size_t j = i;
+        while (j > 0 && compare(base + (j - 1) * element_size, scratch) > 0) {
+            j--;
+        }
+        memmove(base + (j + 1) * element_size, base + j * element_size, (i - j) * element_size);
+        copy_element(base + j * element_size, scratch, element_size);
+    }
+}
+
+// Sorts base[0, n) on one thread with tmp[0, n) as scratch; the result ends up in 'base'.
+static void merge_sort_serial(char* base, char* tmp, size_t n, size_t element_size, CompareFn compare) {
+    for (size_t i = 0; i < n; i += INSERTION_RUN) {
+        size_t len = n - i < INSERTION_RUN ? n - i : INSERTION_RUN;
+        insertion_sort(base + i * element_size, len, element_size, compare, tmp);
+    }
+    char* src = base;
+    char* dst = tmp;
+    for (size_t width = INSERTION_RUN; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = n - lo > width ? lo + width : n;
+            size_t hi = n - mid > width ? mid + width : n;
+            merge_runs(src + lo * element_size, mid - lo, src + mid * element_size, hi - mid,
+                       dst + lo * element_size, element_size, compare);
+        }
+        char* swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != base) {
+        memcpy(base, src, n * element_size);
+    }
+}
+
+// Merge path: how many of the first 'k' merged elements come from 'a', for
+// the same tie rule as merge_runs. Lets independent tasks each produce one
+// slice of a single merge.
+static size_t co_rank(size_t k, const char* a, size_t na, const char* b, size_t nb,
+                      size_t element_size, CompareFn compare) {
+    size_t lo = k > nb ? k - nb : 0;
+    size_t hi = k < na ? k : na;
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2;
+        size_t j = k - i;
+        if (compare(b + (j - 1) * element_size, a + i * element_size) < 0) {
+            hi = i;
+        } else {
+            lo = i + 1;
+        }
+    }
+    return lo;
+}
+
+typedef struct SortJob {
+    char* data;
+    char* tmp;
+    size_t n;
+    size_t element_size;
+    CompareFn compare;
+    size_t runs;     // Chunks sorted independently in the first phase
+    // State of the current merge pass
+    const char* src;
+    char* dst;
+    size_t width;    // Chunks per input run
+    size_t segments; // Tasks sharing one pair of runs
+} SortJob;
+
+static void sort_chunk_task(void* arg, size_t chunk) {
+    SortJob* job = (SortJob*)arg;
+    size_t begin = split_point(job->n, chunk, job->runs);
+    size_t end = split_point(job->n, chunk + 1, job->runs);
+    size_t offset = begin * job->element_size;
+    merge_sort_serial(job->data + offset, job->tmp + offset, end - begin, job->element_size, job->compare);
+}
+
+// Element index where the run starting at chunk 'chunk' begins, clamped to the end.
+static size_t run_start(const SortJob* job, size_t chunk) {
+    return chunk < job->runs ? split_point(job->n, chunk, job->runs) : job->n;
+}
+
+static void merge_slice_task(void* arg, size_t task) {
+    SortJob* job = (SortJob*)arg;
+    size_t es = job->element_size;
+    size_t pair = task / job->segments;
+    size_t segment = task % job->segments;
+    size_t lo = run_start(job, 2 * pair * job->width);
+    size_t mid = run_start(job, (2 * pair + 1) * job->width);
+    size_t hi = run_start(job, (2 * pair + 2) * job->width);
+    const char* a = job->src + lo * es;
+    const char* b = job->src + mid * es;
+    size_t na = mid - lo;
+    size_t nb = hi - mid;
+    size_t k0 = split_point(hi - lo, segment, job->segments);
+    size_t k1 = split_point(hi - lo, segment + 1, job->segments);
+    size_t i0 = co_rank(k0, a, na, b, nb, es, job->compare);
+    size_t i1 = co_rank(k1, a, na, b, nb, es, job->compare);
+    merge_runs(a + i0 * es, i1 - i0, b + (k0 - i0) * es, (k1 - i1) - (k0 - i0),
+               job->dst + (lo + k0) * es, es, job->compare);
+}
+
+int vector_sort(Vector* vec, int (*compare)(const void*, const void*)) {
+    if (vec == NULL || compare == NULL) {
+        DIAG_ERROR_MSG("Vector or comparator is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    size_t n = vec->size;
+    if (n < 2) {
+        return LIB_OK;
+    }
+    size_t es = vec->element_size;
+    char* tmp = (char*)malloc(n * es);
+    if (tmp == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate %zu bytes of sort scratch.", n * es);
+        return LIB_ERR_NO_MEMORY;
+    }
+    ThreadPool* pool = thread_pool_default();
+    size_t threads = thread_pool_concurrency(pool);
+    if (n < SORT_SERIAL_THRESHOLD || threads == 1) {
+        merge_sort_serial(vec->data, tmp, n, es, compare);
+        free(tmp);
+        return LIB_OK;
+    }
+
+    // Phase 1: one sorted run per thread
+    SortJob job;
+    job.data = vec->data;
+    job.tmp = tmp;
+    job.n = n;
+    job.element_size = es;
+    job.compare = compare;
+    job.runs = threads;
+    thread_pool_run(pool, sort_chunk_task, &job, job.runs);
+
+    // Phase 2: merge pairs of runs, each merge cut into slices by co-rank so
+    // that even the final two-way merge keeps every thread busy
+    job.src = vec->data;
+    job.dst = tmp;
+    for (job.width = 1; job.width < job.runs; job.width *= 2) {
+        size_t pairs = (job.runs + 2 * job.width - 1) / (2 * job.width);
+        size_t target = threads * MERGE_TASKS_PER_THREAD;
+        job.segments = (target + pairs - 1) / pairs;
+        thread_pool_run(pool, merge_slice_task, &job, pairs * job.segments);
+        char* swap = (char*)job.src;
+        job.src = job.dst;
+        job.dst = swap;
+    }
+    if (job.src != vec->data) {
+        parallel_copy(pool, vec->data, job.src, n * es);
+    }
+    free(tmp);
+    return LIB_OK;
+}
+
+// --- Radix sort ---
+
+typedef struct RadixJob {
+    const char* src;
+    char* dst;
+    size_t n;
+    size_t element_size;
+    size_t key_offset;
+    size_t key_bytes;   // 4 or 8
+    uint64_t sign_flip; // Flips the sign bit so signed keys order as unsigned
+    unsigned shift;     // Bit offset of the current digit
+    size_t chunks;
+    size_t* counts;     // chunks x RADIX_BUCKETS; histogram, then write offsets
+} RadixJob;
+
+static inline uint64_t radix_key(const RadixJob* job, const char* element) {
+    if (job->key_bytes == 4) {
+        uint32_t key;
+        memcpy(&key, element + job->key_offset, sizeof(key));
+        return (uint64_t)(key ^ (uint32_t)job->sign_flip);
+    }
+    uint64_t key;
+    memcpy(&key, element + job->key_offset, sizeof(key));
+    return key ^ job->sign_flip;
+}
+
+static void radix_histogram_task(void* arg, size_t chunk) {
+    RadixJob* job = (RadixJob*)arg;
+    size_t* counts = job->counts + chunk * RADIX_BUCKETS;
+    memset(counts, 0, RADIX_BUCKETS * sizeof(size_t));
+    size_t end = split_point(job->n, chunk + 1, job->chunks);
+    for (size_t i = split_point(job->n, chunk, job->chunks); i < end; ++i) {
+        counts[(radix_key(job, job->src + i * job->element_size) >> job->shift) & (RADIX_BUCKETS - 1)]++;
+    }
+}
+
+static void radix_scatter_task(void* arg, size_t chunk) {
+    RadixJob* job = (RadixJob*)arg;
+    size_t* offsets = job->counts + chunk * RADIX_BUCKETS;
+    size_t es = job->element_size;
+    size_t end = split_point(job->n, chunk + 1, job->chunks);
+    for (size_t i = split_point(job->n, chunk, job->chunks); i < end; ++i) {
+        const char* element = job->src + i * es;
+        size_t digit = (radix_key(job, element) >> job->shift) & (RADIX_BUCKETS - 1);
+        copy_element(job->dst + offsets[digit]++ * es, element, es);
+    }
+}
+
+// Turns the per-chunk histograms into write offsets: bucket-major, then chunk
+// order, which keeps every pass stable. Returns 0 if all keys share one
+// digit, in which case the pass would not move anything.
+static int radix_prefix(RadixJob* job) {
+    size_t running = 0;
+    for (size_t digit = 0; digit < RADIX_BUCKETS; ++digit) {
+        size_t total = 0;
+        for (size_t chunk = 0; chunk < job->chunks; ++chunk) {
+            size_t* slot = &job->counts[chunk * RADIX_BUCKETS + digit];
+            size_t count = *slot;
+            *slot = running + total;
+            total += count;
+        }
+        if (total == job->n) {
+            return 0;
+        }
+        running += total;
+    }
+    return 1;
+}
+
+int vector_sort_by_key(Vector* vec, size_t key_offset, VectorKeyType key_type) {
+    if (vec == NULL) {
+        DIAG_ERROR_MSG("Vector is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    size_t key_bytes;
+    uint64_t sign_flip;
+    switch (key_type) {
+        case VECTOR_KEY_INT32:  key_bytes = 4; sign_flip = UINT64_C(1) << 31; break;
+        case VECTOR_KEY_UINT32: key_bytes = 4; sign_flip = 0; break;
+        case VECTOR_KEY_INT64:  key_bytes = 8; sign_flip = UINT64_C(1) << 63; break;
+        case VECTOR_KEY_UINT64: key_bytes = 8; sign_flip = 0; break;
+        default:
+            DIAG_ERROR_MSG("Unknown key type %d.", (int)key_type);
+            return LIB_ERR_INVALID_ARG;
+    }
+    if (key_offset > vec->element_size || vec->element_size - key_offset < key_bytes) {
+        DIAG_ERROR_MSG("Key at offset %zu does not fit in %zu-byte elements.", key_offset, vec->element_size);
+        return LIB_ERR_INVALID_ARG;
+    }
+    size_t n = vec->size;
+    if (n < 2) {
+        return LIB_OK;
+    }
+    ThreadPool* pool = thread_pool_default();
+    size_t chunks = n < RADIX_SERIAL_THRESHOLD ? 1 : thread_pool_concurrency(pool);
+    char* tmp = (char*)malloc(n * vec->element_size);
+    size_t* counts = (size_t*)malloc(chunks * RADIX_BUCKETS * sizeof(size_t));
+    if (tmp == NULL || counts == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate radix sort scratch.");
+        free(tmp);
+        free(counts);
+        return LIB_ERR_NO_MEMORY;
+    }
+
+    RadixJob job;
+    job.src = vec->data;
+    job.dst = tmp;
+    job.n = n;
+    job.element_size = vec->element_size;
+    job.key_offset = key_offset;
+    job.key_bytes = key_bytes;
+    job.sign_flip = sign_flip;
+    job.chunks = chunks;
+    job.counts = counts;
+    // LSD order: one stable pass per byte of the key, least significant first
+    for (unsigned shift = 0; shift < key_bytes * 8; shift += 8) {
+        job.shift = shift;
+        thread_pool_run(pool, radix_histogram_task, &job, chunks);
+        if (!radix_prefix(&job)) {
+            continue; // Every key has the same byte here
+        }
+        thread_pool_run(pool, radix_scatter_task, &job, chunks);
+        const char* swap = job.src;
+        job.src = job.dst;
+        job.dst = (char*)swap;
+    }
+    if (job.src != vec->data) {
+        parallel_copy(pool, vec->data, job.src, n * vec->element_size);
+    }
+    free(counts);
+    free(tmp);
+    return LIB_OK;
+}
+
+// --- Parallel for ---
+
+typedef struct ForJob {
+    Vector* vec;
+    VectorChunkFn fn;
+    void* ctx;
+    size_t chunks;
+} ForJob;
+
+static void parallel_for_task(void* arg, size_t chunk) {
+    ForJob* job = (ForJob*)arg;
+    size_t begin = split_point(job->vec->size, chunk, job->chunks);
+    size_t end = split_point(job->vec->size, chunk + 1, job->chunks);
+    job->fn(job->vec->data + begin * job->vec->element_size, begin, end - begin, job->ctx);
+}
+
+int vector_parallel_for(Vector* vec, VectorChunkFn fn, void* ctx) {
+    if (vec == NULL || fn == NULL) {
+        DIAG_ERROR_MSG("Vector or chunk function is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (vec->size == 0) {
+        return LIB_OK;
+    }
+    ThreadPool* pool = thread_pool_default();
+    size_t chunks = thread_pool_concurrency(pool) * PARALLEL_FOR_CHUNKS_PER_THREAD;
+    size_t max_chunks = (vec->size + PARALLEL_FOR_MIN_CHUNK - 1) / PARALLEL_FOR_MIN_CHUNK;
+    if (chunks > max_chunks) {
+        chunks = max_chunks;
+    }
+    ForJob job = { vec, fn, ctx, chunks };
+    return thread_pool_run(pool, parallel_for_task, &job, chunks);
+}
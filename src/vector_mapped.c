@@ -0,0 +1,259 @@
+// File-backed Vector storage: vector_open_mapped() and vector_sync().
+#define _GNU_SOURCE // For mremap on Linux
+#include "vector.h"
+#include "vector_mapped_internal.h"
+#include "diag_internal.h"  // For DIAG_ERROR_MSG
+#include "stats_internal.h" // For STATS_* counters
+#include <stdint.h> // For uint32_t, uint64_t, SIZE_MAX
+
+#if defined(_WIN32)
+
+Vector* vector_open_mapped(const char* path, size_t element_size) {
+    (void)path;
+    (void)element_size;
+    DIAG_ERROR_MSG("Mapped vectors are not supported on this platform.");
+    return NULL;
+}
+
+int vector_sync(Vector* vec) {
+    (void)vec;
+    return LIB_ERR_INVALID_ARG;
+}
+
+int vector_mapping_resize(Vector* vec, size_t new_capacity) {
+    (void)vec;
+    (void)new_capacity;
+    return LIB_ERR_INVALID_ARG;
+}
+
+void vector_mapping_close(Vector* vec) {
+    (void)vec;
+}
+
+#else
+
+#include <fcntl.h>    // For open
+#include <string.h>   // For memcmp, memcpy
+#include <sys/file.h> // For flock
+#include <sys/mman.h> // For mmap, mremap, msync, munmap
+#include <sys/stat.h> // For fstat
+#include <unistd.h>   // For ftruncate, close
+
+#define VECTOR_FILE_MAGIC "MYCVEC\0\0"
+#define VECTOR_FILE_VERSION 1u
+// Elements start one cache line into the file, so the page-aligned mapping
+// leaves them 64-byte aligned.
+#define VECTOR_FILE_HEADER_SIZE 64u
+// A new file starts with as many elements as fit in its first page.
+#define VECTOR_FILE_INITIAL_BYTES 4096u
+
+// On-disk header at offset 0. Fields are native-endian; a file is meant to be
+// reopened on the machine that wrote it.
+typedef struct VectorFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;   // Offset of the first element
+    uint64_t element_size;
+    uint64_t size;          // Live elements as of the last vector_sync()/vector_destroy()
+    uint64_t capacity;      // Element slots the file has room for
+} VectorFileHeader;
+
+_Static_assert(sizeof(VectorFileHeader) <= VECTOR_FILE_HEADER_SIZE, "header must fit before the elements");
+
+typedef struct VectorMapping {
+    int fd;
+    char* base;    // Start of the mapping, i.e. the header
+    size_t length; // Bytes mapped, equal to the file length
+} VectorMapping;
+
+static VectorFileHeader* mapping_header(const Vector* vec) {
+    return (VectorFileHeader*)vec->mapping->base;
+}
+
+// Returns the file length for 'capacity' elements, or 0 on overflow.
+static size_t file_length(size_t capacity, size_t element_size) {
+    if (capacity > (SIZE_MAX - VECTOR_FILE_HEADER_SIZE) / element_size) {
+        return 0;
+    }
+    return VECTOR_FILE_HEADER_SIZE + capacity * element_size;
+}
+
+// Moves an existing mapping to 'new_length' bytes; the file must already be that long.
+// On failure the old mapping is left in place, so the vector stays usable.
+static char* remap(VectorMapping* mapping, size_t new_length) {
+#if defined(__linux__)
+    void* base = mremap(mapping->base, mapping->length, new_length, MREMAP_MAYMOVE);
+#else
+    // Map the new length alongside the old one and unmap the old one only once that worked
+    void* base = mmap(NULL, new_length, PROT_READ | PROT_WRITE, MAP_SHARED, mapping->fd, 0);
+    if (base != MAP_FAILED) {
+        munmap(mapping->base, mapping->length);
+    }
+#endif
+    return base == MAP_FAILED ? NULL : (char*)base;
+}
+
+// Checks a header read from an existing file against the caller's element size and the file length.
+static int header_valid(const VectorFileHeader* header, size_t element_size, size_t file_size) {
+    if (memcmp(header->magic, VECTOR_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != VECTOR_FILE_VERSION ||
+        header->header_size != VECTOR_FILE_HEADER_SIZE) {
+        DIAG_ERROR_MSG("File is not a vector file of a supported version.");
+        return 0;
+    }
+    if (header->element_size != element_size) {
+        DIAG_ERROR_MSG("File holds %llu-byte elements, not %zu.",
+                       (unsigned long long)header->element_size, element_size);
+        return 0;
+    }
+    if (header->capacity == 0 || header->size > header->capacity || header->capacity > SIZE_MAX ||
+        file_length((size_t)header->capacity, element_size) == 0 ||
+        file_length((size_t)header->capacity, element_size) > file_size) {
+        DIAG_ERROR_MSG("Vector file header does not match the file length.");
+        return 0;
+    }
+    return 1;
+}
+
+Vector* vector_open_mapped(const char* path, size_t element_size) {
+    if (path == NULL || element_size == 0) {
+        DIAG_ERROR_MSG("Path is NULL or element size is 0.");
+        return NULL;
+    }
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        DIAG_ERROR_MSG("Cannot open %s.", path);
+        return NULL;
+    }
+    // One writer at a time: a second process growing the same file would corrupt it
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        DIAG_ERROR_MSG("%s is already open in another vector.", path);
+        close(fd);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        DIAG_ERROR_MSG("Cannot stat %s.", path);
+        close(fd);
+        return NULL;
+    }
+
+    int fresh = st.st_size == 0;
+    size_t length;
+    if (fresh) {
+        size_t capacity = (VECTOR_FILE_INITIAL_BYTES - VECTOR_FILE_HEADER_SIZE) / element_size;
+        length = file_length(capacity > 0 ? capacity : 1, element_size);
+        if (length == 0 || ftruncate(fd, (off_t)length) != 0) {
+            DIAG_ERROR_MSG("Cannot size new vector file %s.", path);
+            close(fd);
+            return NULL;
+        }
+    } else {
+        if ((uintmax_t)st.st_size < VECTOR_FILE_HEADER_SIZE || (uintmax_t)st.st_size > SIZE_MAX) {
+            DIAG_ERROR_MSG("%s is too short or too long to be a vector file.", path);
+            close(fd);
+            return NULL;
+        }
+        length = (size_t)st.st_size;
+    }
+
+    void* base = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        DIAG_ERROR_MSG("Cannot map %s.", path);
+        close(fd);
+        return NULL;
+    }
+    VectorFileHeader* header = (VectorFileHeader*)base;
+    if (fresh) {
+        memcpy(header->magic, VECTOR_FILE_MAGIC, sizeof(header->magic));
+        header->version = VECTOR_FILE_VERSION;
+        header->header_size = VECTOR_FILE_HEADER_SIZE;
+        header->element_size = element_size;
+        header->size = 0;
+        header->capacity = (length - VECTOR_FILE_HEADER_SIZE) / element_size;
+    } else if (!header_valid(header, element_size, length)) {
+        munmap(base, length);
+        close(fd);
+        return NULL;
+    }
+
+    const Allocator* allocator = allocator_default();
+    Vector* vec = (Vector*)allocator->alloc(allocator->ctx, sizeof(Vector));
+    VectorMapping* mapping = (VectorMapping*)allocator->alloc(allocator->ctx, sizeof(VectorMapping));
+    if (vec == NULL || mapping == NULL) {
+        DIAG_ERROR_MSG("Failed to allocate memory for the mapped Vector.");
+        allocator->free(allocator->ctx, vec, sizeof(Vector));
+        allocator->free(allocator->ctx, mapping, sizeof(VectorMapping));
+        munmap(base, length);
+        close(fd);
+        return NULL;
+    }
+    mapping->fd = fd;
+    mapping->base = (char*)base;
+    mapping->length = length;
+    // Reopening is zero-copy: the elements are used in place
+    vec->data = mapping->base + VECTOR_FILE_HEADER_SIZE;
+    vec->size = (size_t)header->size;
+    vec->capacity = (size_t)header->capacity;
+    vec->element_size = element_size;
+    vec->allocator = allocator;
+    vec->mapping = mapping;
+    STATS_RESET(vec);
+    STATS_SET(vec, current_bytes, length);
+    STATS_SET(vec, peak_bytes, length);
+    STATS_SET(vec, peak_size, vec->size);
+    return vec;
+}
+
+int vector_sync(Vector* vec) {
+    if (vec == NULL || vec->mapping == NULL) {
+        DIAG_ERROR_MSG("Vector is NULL or not file-backed.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    mapping_header(vec)->size = vec->size;
+    if (msync(vec->mapping->base, vec->mapping->length, MS_SYNC) != 0) {
+        DIAG_ERROR_MSG("msync failed.");
+        return LIB_ERR_IO;
+    }
+    return LIB_OK;
+}
+
+int vector_mapping_resize(Vector* vec, size_t new_capacity) {
+    VectorMapping* mapping = vec->mapping;
+    size_t new_length = file_length(new_capacity, vec->element_size);
+    if (new_length == 0) {
+        DIAG_ERROR_MSG("Requested capacity overflows size_t.");
+        return LIB_ERR_NO_MEMORY;
+    }
+    // Grow the file before the mapping, and shrink it only after the mapping,
+    // so no mapped page ever lies beyond the end of the file.
+    if (new_length > mapping->length && ftruncate(mapping->fd, (off_t)new_length) != 0) {
+        DIAG_ERROR_MSG("Cannot extend the vector file to %zu bytes.", new_length);
+        return LIB_ERR_IO;
+    }
+    char* base = remap(mapping, new_length);
+    if (base == NULL) {
+        DIAG_ERROR_MSG("Cannot remap the vector file to %zu bytes.", new_length);
+        return LIB_ERR_NO_MEMORY;
+    }
+    if (new_length < mapping->length && ftruncate(mapping->fd, (off_t)new_length) != 0) {
+        DIAG_ERROR_MSG("Cannot truncate the vector file; keeping its old length.");
+    }
+    mapping->base = base;
+    mapping->length = new_length;
+    mapping_header(vec)->capacity = new_capacity;
+    vec->data = base + VECTOR_FILE_HEADER_SIZE;
+    vec->capacity = new_capacity;
+    return LIB_OK;
+}
+
+void vector_mapping_close(Vector* vec) {
+    VectorMapping* mapping = vec->mapping;
+    mapping_header(vec)->size = vec->size; // Durable once the kernel writes the page back
+    munmap(mapping->base, mapping->length);
+    close(mapping->fd); // Also drops the flock
+    vec->allocator->free(vec->allocator->ctx, mapping, sizeof(VectorMapping));
+    vec->mapping = NULL;
+}
+
+#endif // _WIN32
@@ -0,0 +1,18 @@
+#ifndef VECTOR_MAPPED_INTERNAL_H
+#define VECTOR_MAPPED_INTERNAL_H
+
+#include <stddef.h>
+#include "vector.h"
+
+// Library-private side of vector_open_mapped(). vector.c routes capacity
+// changes and destruction of a mapped vector here instead of to its allocator.
+
+// Resizes the backing file and the mapping to hold 'new_capacity' elements,
+// updating vec->data and vec->capacity. Returns a LibStatus.
+int vector_mapping_resize(Vector* vec, size_t new_capacity);
+
+// Records the current size in the file header, unmaps and closes the file,
+// and frees the mapping bookkeeping. Does not free the Vector itself.
+void vector_mapping_close(Vector* vec);
+
+#endif // VECTOR_MAPPED_INTERNAL_H
@@ -0,0 +1,522 @@
+#include "vector_ops.h"
+#include "diag_internal.h" // For DIAG_ERROR_MSG
+
+// Each kernel comes in up to three flavours over a raw (pointer, count) range:
+//   _avx2   - 256-bit lanes, compiled with a per-function target attribute so
+//             the rest of the library keeps the baseline instruction set
+//   _sse2   - 128-bit lanes, always available on x86-64
+//   _scalar - plain loops, used when the compiler cannot target x86
+// The public functions validate the Vector and pick a flavour per call;
+// __builtin_cpu_supports reads a flag libgcc fills in once at startup.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && defined(__SSE2__)
+#define VECTOR_OPS_X86 1
+#include <immintrin.h>
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+// Lane counters in count_eq are 32 bits wide; flushing them every this many
+// elements keeps each lane far below 2^32 matches.
+#define COUNT_CHUNK ((size_t)1 << 24)
+
+#ifdef VECTOR_OPS_X86
+
+// --- SSE2 ---
+
+static size_t find_i32_sse2(const int32_t* p, size_t n, int32_t value) {
+    const __m128i needle = _mm_set1_epi32(value);
+    size_t i = 0;
+    // Test 16 elements per iteration; on a hit, the scalar loop below pins it down
+    for (; i + 16 <= n; i += 16) {
+        __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(p + i)), needle);
+        __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(p + i + 4)), needle);
+        __m128i c = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(p + i + 8)), needle);
+        __m128i d = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(p + i + 12)), needle);
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))) != 0) {
+            break;
+        }
+    }
+    for (; i < n; ++i) {
+        if (p[i] == value) {
+            return i;
+        }
+    }
+    return n;
+}
+
+static size_t count_eq_i32_sse2(const int32_t* p, size_t n, int32_t value) {
+    const __m128i needle = _mm_set1_epi32(value);
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        // A match compares to -1, so subtracting the mask adds one per hit
+        acc = _mm_sub_epi32(acc, _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(p + i)), needle));
+    }
+    uint32_t lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    size_t count = (size_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < n; ++i) {
+        count += (p[i] == value);
+    }
+    return count;
+}
+
+static int64_t sum_i32_sse2(const int32_t* p, size_t n) {
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        // Sign-extend to 64 bits by interleaving each lane with its sign mask
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        __m128i sign = _mm_srai_epi32(v, 31);
+        acc0 = _mm_add_epi64(acc0, _mm_unpacklo_epi32(v, sign));
+        acc1 = _mm_add_epi64(acc1, _mm_unpackhi_epi32(v, sign));
+    }
+    int64_t lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, _mm_add_epi64(acc0, acc1));
+    int64_t sum = lanes[0] + lanes[1];
+    for (; i < n; ++i) {
+        sum += p[i];
+    }
+    return sum;
+}
+
+// SSE2 has no pminsd/pmaxsd (those are SSE4.1), so select through a compare mask.
+static inline __m128i select_epi32(__m128i mask, __m128i if_set, __m128i if_clear) {
+    return _mm_or_si128(_mm_and_si128(mask, if_set), _mm_andnot_si128(mask, if_clear));
+}
+
+static int32_t min_i32_sse2(const int32_t* p, size_t n) {
+    __m128i acc = _mm_set1_epi32(p[0]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        acc = select_epi32(_mm_cmplt_epi32(v, acc), v, acc);
+    }
+    int32_t lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    int32_t result = lanes[0];
+    for (int k = 1; k < 4; ++k) {
+        result = lanes[k] < result ? lanes[k] : result;
+    }
+    for (; i < n; ++i) {
+        result = p[i] < result ? p[i] : result;
+    }
+    return result;
+}
+
+static int32_t max_i32_sse2(const int32_t* p, size_t n) {
+    __m128i acc = _mm_set1_epi32(p[0]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        acc = select_epi32(_mm_cmpgt_epi32(v, acc), v, acc);
+    }
+    int32_t lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    int32_t result = lanes[0];
+    for (int k = 1; k < 4; ++k) {
+        result = lanes[k] > result ? lanes[k] : result;
+    }
+    for (; i < n; ++i) {
+        result = p[i] > result ? p[i] : result;
+    }
+    return result;
+}
+
+static double sum_f32_sse2(const float* p, size_t n) {
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(p + i);
+        acc0 = _mm_add_pd(acc0, _mm_cvtps_pd(v));
+        acc1 = _mm_add_pd(acc1, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+    double sum = lanes[0] + lanes[1];
+    for (; i < n; ++i) {
+        sum += p[i];
+    }
+    return sum;
+}
+
+static float min_f32_sse2(const float* p, size_t n) {
+    __m128 acc = _mm_set1_ps(p[0]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm_min_ps(acc, _mm_loadu_ps(p + i));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    float result = lanes[0];
+    for (int k = 1; k < 4; ++k) {
+        result = lanes[k] < result ? lanes[k] : result;
+    }
+    for (; i < n; ++i) {
+        result = p[i] < result ? p[i] : result;
+    }
+    return result;
+}
+
+static float max_f32_sse2(const float* p, size_t n) {
+    __m128 acc = _mm_set1_ps(p[0]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm_max_ps(acc, _mm_loadu_ps(p + i));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    float result = lanes[0];
+    for (int k = 1; k < 4; ++k) {
+        result = lanes[k] > result ? lanes[k] : result;
+    }
+    for (; i < n; ++i) {
+        result = p[i] > result ? p[i] : result;
+    }
+    return result;
+}
+
+// --- AVX2 ---
+
+AVX2_TARGET
+static size_t find_i32_avx2(const int32_t* p, size_t n, int32_t value) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(p + i)), needle);
+        __m256i b = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(p + i + 8)), needle);
+        __m256i c = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(p + i + 16)), needle);
+        __m256i d = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(p + i + 24)), needle);
+        if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d))) != 0) {
+            break;
+        }
+    }
+    for (; i < n; ++i) {
+        if (p[i] == value) {
+            return i;
+        }
+    }
+    return n;
+}
+
+AVX2_TARGET
+static size_t count_eq_i32_avx2(const int32_t* p, size_t n, int32_t value) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_sub_epi32(acc0, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(p + i)), needle));
+        acc1 = _mm256_sub_epi32(acc1, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(p + i + 8)), needle));
+    }
+    uint32_t lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, _mm256_add_epi32(acc0, acc1));
+    size_t count = 0;
+    for (int k = 0; k < 8; ++k) {
+        count += lanes[k];
+    }
+    for (; i < n; ++i) {
+        count += (p[i] == value);
+    }
+    return count;
+}
+
+AVX2_TARGET
+static int64_t sum_i32_avx2(const int32_t* p, size_t n) {
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(p + i))));
+        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(p + i + 4))));
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, _mm256_add_epi64(acc0, acc1));
+    int64_t sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < n; ++i) {
+        sum += p[i];
+    }
+    return sum;
+}
+
+AVX2_TARGET
+static int32_t min_i32_avx2(const int32_t* p, size_t n) {
+    __m256i acc = _mm256_set1_epi32(p[0]);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm256_min_epi32(acc, _mm256_loadu_si256((const __m256i*)(p + i)));
+    }
+    int32_t lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    int32_t result = lanes[0];
+    for (int k = 1; k < 8; ++k) {
+        result = lanes[k] < result ? lanes[k] : result;
+    }
+    for (; i < n; ++i) {
+        result = p[i] < result ? p[i] : result;
+    }
+    return result;
+}
+
+AVX2_TARGET
+static int32_t max_i32_avx2(const int32_t* p, size_t n) {
+    __m256i acc = _mm256_set1_epi32(p[0]);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm256_max_epi32(acc, _mm256_loadu_si256((const __m256i*)(p + i)));
+    }
+    int32_t lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    int32_t result = lanes[0];
+    for (int k = 1; k < 8; ++k) {
+        result = lanes[k] > result ? lanes[k] : result;
+    }
+    for (; i < n; ++i) {
+        result = p[i] > result ? p[i] : result;
+    }
+    return result;
+}
+
+AVX2_TARGET
+static double sum_f32_avx2(const float* p, size_t n) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm_loadu_ps(p + i)));
+        acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm_loadu_ps(p + i + 4)));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+    double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < n; ++i) {
+        sum += p[i];
+    }
+    return sum;
+}
+
+AVX2_TARGET
+static float min_f32_avx2(const float* p, size_t n) {
+    __m256 acc = _mm256_set1_ps(p[0]);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm256_min_ps(acc, _mm256_loadu_ps(p + i));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, acc);
+    float result = lanes[0];
+    for (int k = 1; k < 8; ++k) {
+        result = lanes[k] < result ? lanes[k] : result;
+    }
+    for (; i < n; ++i) {
+        result = p[i] < result ? p[i] : result;
+    }
+    return result;
+}
+
+AVX2_TARGET
+static float max_f32_avx2(const float* p, size_t n) {
+    __m256 acc = _mm256_set1_ps(p[0]);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm256_max_ps(acc, _mm256_loadu_ps(p + i));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, acc);
+    float result = lanes[0];
+    for (int k = 1; k < 8; ++k) {
+        result = lanes[k] > result ? lanes[k] : result;
+    }
+    for (; i < n; ++i) {
+        result = p[i] > result ? p[i] : result;
+    }
+    return result;
+}
+
+#define VECTOR_OPS_DISPATCH(kernel, ...) \
+    (__builtin_cpu_supports("avx2") ? kernel##_avx2(__VA_ARGS__) : kernel##_sse2(__VA_ARGS__))
+
+#else // !VECTOR_OPS_X86
+
+// --- Scalar fallback ---
+
+static size_t find_i32_scalar(const int32_t* p, size_t n, int32_t value) {
+    for (size_t i = 0; i < n; ++i) {
+        if (p[i] == value) {
+            return i;
+        }
+    }
+    return n;
+}
+
+static size_t count_eq_i32_scalar(const int32_t* p, size_t n, int32_t value) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        count += (p[i] == value);
+    }
+    return count;
+}
+
+static int64_t sum_i32_scalar(const int32_t* p, size_t n) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += p[i];
+    }
+    return sum;
+}
+
+static int32_t min_i32_scalar(const int32_t* p, size_t n) {
+    int32_t result = p[0];
+    for (size_t i = 1; i < n; ++i) {
+        result = p[i] < result ? p[i] : result;
+    }
+    return result;
+}
+
+static int32_t max_i32_scalar(const int32_t* p, size_t n) {
+    int32_t result = p[0];
+    for (size_t i = 1; i < n; ++i) {
+        result = p[i] > result ? p[i] : result;
+    }
+    return result;
+}
+
+static double sum_f32_scalar(const float* p, size_t n) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += p[i];
+    }
+    return sum;
+}
+
+static float min_f32_scalar(const float* p, size_t n) {
+    float result = p[0];
+    for (size_t i = 1; i < n; ++i) {
+        result = p[i] < result ? p[i] : result;
+    }
+    return result;
+}
+
+static float max_f32_scalar(const float* p, size_t n) {
+    float result = p[0];
+    for (size_t i = 1; i < n; ++i) {
+        result = p[i] > result ? p[i] : result;
+    }
+    return result;
+}
+
+#define VECTOR_OPS_DISPATCH(kernel, ...) kernel##_scalar(__VA_ARGS__)
+
+#endif // VECTOR_OPS_X86
+
+// --- Public API ---
+
+// Common argument check: non-NULL vector and output, matching element size.
+static int check_args(const Vector* vec, size_t element_size, const void* out) {
+    if (vec == NULL || out == NULL) {
+        DIAG_ERROR_MSG("Vector or output pointer is NULL.");
+        return LIB_ERR_INVALID_ARG;
+    }
+    if (vec->element_size != element_size) {
+        DIAG_ERROR_MSG("Element size %zu does not match the kernel's %zu.", vec->element_size, element_size);
+        return LIB_ERR_INVALID_ARG;
+    }
+    return LIB_OK;
+}
+
+// min/max have no identity element, so they also reject an empty vector.
+static int check_nonempty(const Vector* vec, size_t element_size, const void* out) {
+    int status = check_args(vec, element_size, out);
+    if (status != LIB_OK) {
+        return status;
+    }
+    if (vec->size == 0) {
+        DIAG_ERROR_MSG("Vector is empty.");
+        return LIB_ERR_OUT_OF_RANGE;
+    }
+    return LIB_OK;
+}
+
+int vector_find_int32(const Vector* vec, int32_t value, size_t* index) {
+    int status = check_args(vec, sizeof(int32_t), index);
+    if (status != LIB_OK) {
+        return status;
+    }
+    const int32_t* p = (const int32_t*)vec->data;
+    size_t found = VECTOR_OPS_DISPATCH(find_i32, p, vec->size, value);
+    if (found == vec->size) {
+        return LIB_ERR_NOT_FOUND;
+    }
+    *index = found;
+    return LIB_OK;
+}
+
+int vector_count_eq_int32(const Vector* vec, int32_t value, size_t* count) {
+    int status = check_args(vec, sizeof(int32_t), count);
+    if (status != LIB_OK) {
+        return status;
+    }
+    const int32_t* p = (const int32_t*)vec->data;
+    size_t total = 0;
+    for (size_t base = 0; base < vec->size; base += COUNT_CHUNK) {
+        size_t len = vec->size - base < COUNT_CHUNK ? vec->size - base : COUNT_CHUNK;
+        total += VECTOR_OPS_DISPATCH(count_eq_i32, p + base, len, value);
+    }
+    *count = total;
+    return LIB_OK;
+}
+
+int vector_sum_int32(const Vector* vec, int64_t* sum) {
+    int status = check_args(vec, sizeof(int32_t), sum);
+    if (status != LIB_OK) {
+        return status;
+    }
+    *sum = VECTOR_OPS_DISPATCH(sum_i32, (const int32_t*)vec->data, vec->size);
+    return LIB_OK;
+}
+
+int vector_min_int32(const Vector* vec, int32_t* min) {
+    int status = check_nonempty(vec, sizeof(int32_t), min);
+    if (status != LIB_OK) {
+        return status;
+    }
+    *min = VECTOR_OPS_DISPATCH(min_i32, (const int32_t*)vec->data, vec->size);
+    return LIB_OK;
+}
+
+int vector_max_int32(const Vector* vec, int32_t* max) {
+    int status = check_nonempty(vec, sizeof(int32_t), max);
+    if (status != LIB_OK) {
+        return status;
+    }
+    *max = VECTOR_OPS_DISPATCH(max_i32, (const int32_t*)vec->data, vec->size);
+    return LIB_OK;
+}
+
+int vector_sum_float(const Vector* vec, double* sum) {
+    int status = check_args(vec, sizeof(float), sum);
+    if (status != LIB_OK) {
+        return status;
+    }
+    *sum = VECTOR_OPS_DISPATCH(sum_f32, (const float*)vec->data, vec->size);
+    return LIB_OK;
+}
+
+int vector_min_float(const Vector* vec, float* min) {
+    int status = check_nonempty(vec, sizeof(float), min);
+    if (status != LIB_OK) {
+        return status;
+    }
+    *min = VECTOR_OPS_DISPATCH(min_f32, (const float*)vec->data, vec->size);
+    return LIB_OK;
+}
+
+int vector_max_float(const Vector* vec, float* max) {
+    int status = check_nonempty(vec, sizeof(float), max);
+    if (status != LIB_OK) {
+        return status;
+    }
+    *max = VECTOR_OPS_DISPATCH(max_f32, (const float*)vec->data, vec->size);
+    return LIB_OK;
+}